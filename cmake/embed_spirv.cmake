@@ -0,0 +1,37 @@
+# Turns a compiled SPIR-V module into a header holding it as 32-bit words, so the binary does not
+# depend on finding .spv files at runtime.
+#
+#   cmake -DINPUT=<module.spv> -DOUTPUT=<header.hpp> -DNAME=<symbol> -P embed_spirv.cmake
+
+file(READ ${INPUT} HEX HEX)
+string(LENGTH "${HEX}" LENGTH)
+math(EXPR REMAINDER "${LENGTH} % 8")
+
+if(LENGTH EQUAL 0 OR NOT REMAINDER EQUAL 0)
+  message(FATAL_ERROR "${INPUT} is not a whole number of SPIR-V words")
+endif()
+
+# modules are stored little-endian, so each group of four bytes is reversed into one word
+string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u, " WORDS "${HEX}")
+set(WORD "0x[0-9a-f]+u, ")
+string(REGEX REPLACE "(${WORD}${WORD}${WORD}${WORD}${WORD}${WORD}${WORD}${WORD})" "\\1\n" WORDS "${WORDS}")
+string(REGEX REPLACE " \n" "\n    " WORDS "${WORDS}")
+string(REGEX REPLACE "[ ,\n]+$" "" WORDS "${WORDS}")
+
+file(WRITE ${OUTPUT}
+"// generated from ${INPUT} by cmake/embed_spirv.cmake
+
+#ifndef str_spirv_${NAME}_hpp
+#define str_spirv_${NAME}_hpp
+
+namespace str::spirv
+{
+
+inline constexpr unsigned int ${NAME}[] = {
+    ${WORDS}
+};
+
+} // namespace str::spirv
+
+#endif // str_spirv_${NAME}_hpp
+")
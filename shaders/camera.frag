@@ -1,118 +1,18 @@
 #version 460
+#extension GL_GOOGLE_include_directive : require
 
-struct Transform {
-  vec3 position;
-  vec3 rotation;
-  vec3 scale;
-  vec3 color;
-};
-
-struct Ray {
-  vec3 origin;
-  vec3 dir;
-  vec3 color;
-};
-
-struct HitInfo {
-  bool hit;
-  float t;
-  vec3 point;
-  vec3 normal;
-  vec3 color;
-};
-
-layout(set = 0, binding = 0) buffer TransformSSBO {
-  uint size;
-  Transform transforms[];
-} ssbo;
-
-layout(location = 0) in vec3 origin;
-layout(location = 1) in vec3 vPos;
+#include "trace.glsl"
 
 layout(location = 0) out vec4 fColor;
 
-const float inf = float(1.0 / 0.0);
-const vec3 SKY_LIGHT = vec3(0.5294, 0.8078, 0.9216);
-const vec3 SKY_DARK = vec3(0.0980, 0.0980, 0.4392);
-const uint MAX_BOUNCES = 1;
-
-HitInfo RaySphere(Ray, Transform);
-Ray trace(Ray);
-
 void main() {
-  Ray ray = Ray(
-    origin,
-    normalize(vPos - origin),
-    vec3(0.0, 0.0, 0.0)
-  );
-
-  ray = trace(ray);
-
-  fColor = vec4(ray.color, 1.0);
-}
-
-HitInfo RaySphere(Transform transform, Ray ray) {
-  vec3 O = ray.origin - transform.position;
-  float R = transform.scale[0];
-
-  float b = 2 * dot(O, ray.dir);
-  float c = dot(O, O) - R * R;
-  float disc = b * b - 4 * c;
-
-  if (disc < 0) {
-    return HitInfo(
-      false,
-      0.0,
-      vec3(0.0, 0.0, 0.0),
-      vec3(0.0, 0.0, 0.0),
-      vec3(0.0, 0.0, 0.0)
-    );
-  }
-
-  float t = -(b + sqrt(disc)) / 2;
-  vec3 P = ray.origin + t * ray.dir;
-
-  return HitInfo(
-    true,
-    t,
-    P,
-    normalize(P - transform.position),
-    transform.color
-  );
-}
-
-Ray trace(Ray ray) {
-  for (uint i = 0; i < MAX_BOUNCES; ++i) {
-    HitInfo hit = HitInfo(
-      false,
-      float(inf),
-      vec3(0.0, 0.0, 0.0),
-      vec3(0.0, 0.0, 0.0),
-      vec3(0.0, 0.0, 0.0)
-    );
-
-    for (uint j = 0; j < ssbo.size; ++j) {
-      HitInfo info = RaySphere(ssbo.transforms[j], ray);
-
-      if (info.hit && info.t < hit.t) {
-        hit = info;
-      }
-    }
-
-    if (!hit.hit) {
-      float a = abs(dot(ray.dir, vec3(0.0, -1.0, 0.0)));
-      ray.color += (1 - a) * SKY_LIGHT + a * SKY_DARK;
-      return ray;
-    }
-
-    ray.color += abs(dot(ray.dir, hit.normal)) * hit.color;
-    ray.origin = hit.point;
-
-    float alignment = dot(ray.dir, hit.normal);
-    int invert = int(alignment / abs(alignment));
+  ivec2 pixel = ivec2(gl_FragCoord.xy);
+  seedRandom(pixel, frame.seed);
 
-    ray.dir = invert * (ray.dir - 2 * alignment * hit.normal);
-  }
+  // the camera's jitter, rotated per pixel so neighbouring pixels do not alias together
+  vec2 offset = fract(frame.jitter + vec2(random(), random())) - 0.5;
+  Ray ray = cameraRay(gl_FragCoord.xy + offset);
 
-  return ray;
+  fColor = vec4(accumulate(pixel, trace(ray).color, frame.index), 1.0);
+  countSteps();
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef STR_OBJECT_H
+#define STR_OBJECT_H
+
+// the per-object record at binding 0, written once here for both trace.glsl and src/include/object.hpp:
+// each field is (GLSL type, name, std430 offset), and the C++ side checks every offset at compile time
+//   sphere : position in xyz, radius in w
+//   color  : rgba as unorm8, unpacked with unpackUnorm4x8()
+//   flags  : STR_OBJECT_MOVING when the object has a Boost worth fetching at binding 8
+#define STR_OBJECT_FIELDS(FIELD) \
+  FIELD(vec4, sphere, 0) \
+  FIELD(uint, color, 16) \
+  FIELD(uint, flags, 20)
+
+// std430 rounds the 24 bytes of fields up to the vec4's alignment
+#define STR_OBJECT_SIZE 32
+
+#define STR_OBJECT_MOVING 1u
+
+#endif
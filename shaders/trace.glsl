@@ -0,0 +1,620 @@
+#ifndef TRACE_GLSL
+#define TRACE_GLSL
+
+#include "object.h"
+
+#define OBJECT_MEMBER(type, name, offset) type name;
+
+// generated from shaders/object.h, the layout str::ObjectData is checked against
+struct Object {
+  STR_OBJECT_FIELDS(OBJECT_MEMBER)
+};
+
+struct BVHNode {
+  vec3 lo;
+  uint leftFirst;
+  vec3 hi;
+  uint count;
+};
+
+// Lorentz boost from the camera's frame into an object's rest frame, and its velocity and gamma
+struct Boost {
+  mat4 matrix;
+  vec4 motion;
+};
+
+// time is when the light was at origin, counting back from 0 as it reaches the camera
+struct Ray {
+  vec3 origin;
+  vec3 dir;
+  vec3 color;
+  float time;
+};
+
+struct HitInfo {
+  bool hit;
+  bool absorbed;
+  float t;
+  vec3 point;
+  vec3 normal;
+  vec3 color;
+};
+
+layout(set = 0, binding = 0) buffer TransformSSBO {
+  uint size;
+  Object objects[];
+} ssbo;
+
+layout(set = 0, binding = 1) buffer BVHSSBO {
+  BVHNode nodes[];
+} bvh;
+
+layout(set = 0, binding = 2) buffer IndexSSBO {
+  uint indices[];
+} bvhIndices;
+
+layout(set = 0, binding = 3, rgba32f) uniform image2D accumulation;
+
+// written every frame from str::FrameConstants, so the recorded command buffers stay valid as
+// the camera moves and samples accumulate; a ray through pixel p at sub-pixel offset o points
+// at corner + (p.x + o.x) * dx + (p.y + o.y) * dy
+layout(set = 0, binding = 4) uniform Frame {
+  mat4 inverseView;
+  vec3 origin;
+  vec3 corner;
+  vec3 dx;
+  vec3 dy;
+  vec2 jitter;
+  uint index;
+  uint seed;
+  uvec2 extent;
+} frame;
+
+const uint MAX_LENSES = 8;
+
+// point masses bending every ray, and the error control for integrating their geodesics
+layout(set = 0, binding = 5) uniform Spacetime {
+  vec4 lenses[MAX_LENSES];
+  uint count;
+  float relative;
+  float absolute;
+  uint steps;
+  float distance;
+  float escape;
+  uint bending;
+} spacetime;
+
+layout(set = 0, binding = 6) buffer Counters {
+  uint rays;
+  uint steps;
+} counters;
+
+// deflection angle and time delay over rs / b and rs / r0, built once by str::LensingTable
+layout(set = 0, binding = 7) readonly buffer LensingLUT {
+  uint impact;
+  uint distance;
+  float reach;
+  float padding;
+  vec2 deflections[];
+} lensing;
+
+// one per object slot, derived on the CPU by str::computeBoosts() whenever the slot is uploaded
+layout(set = 0, binding = 8) readonly buffer BoostSSBO {
+  Boost boosts[];
+} motion;
+
+const float inf = float(1.0 / 0.0);
+const vec3 SKY_LIGHT = vec3(0.5294, 0.8078, 0.9216);
+const vec3 SKY_DARK = vec3(0.0980, 0.0980, 0.4392);
+const uint MAX_BOUNCES = 1;
+const uint STACK_SIZE = 32; // STR_BVH_MAX_DEPTH, which BVH::build never exceeds
+const float EPSILON = 1e-4;
+const float CRITICAL_IMPACT = 0.38490018;
+const uint BENDING_LOOKUP = 1;
+const float HORIZON = 1000.0;
+const vec3 WAVELENGTHS = vec3(610.0, 550.0, 465.0);
+const vec2 VISIBLE = vec2(380.0, 700.0);
+
+uint rngState;
+uint traceSteps = 0u;
+
+uint pcg(uint);
+float random();
+void seedRandom(ivec2, uint);
+vec3 accumulate(ivec2, vec3, uint);
+float spectrum(vec3, float);
+vec3 shift(vec3, float);
+HitInfo RaySphere(Object, uint, Ray);
+float RayBox(BVHNode, Ray, vec3, float);
+HitInfo intersect(Ray, float);
+vec3 bend(vec3, vec3);
+float dormandPrince(vec3, vec3, vec3, float, out vec3, out vec3, out vec3);
+float nearestLens(vec3);
+bool captured(vec3);
+bool escaped(vec3, vec3);
+vec2 deflection(float, float);
+HitInfo deflect(inout Ray);
+HitInfo propagate(inout Ray);
+Ray cameraRay(vec2);
+Ray trace(Ray);
+void countSteps();
+
+uint pcg(uint v) {
+  uint state = v * 747796405u + 2891336453u;
+  uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+  return (word >> 22u) ^ word;
+}
+
+float random() {
+  rngState = pcg(rngState);
+  return float(rngState) / 4294967296.0;
+}
+
+// the object's spectrum at lambda, running linearly through its blue, green and red channels and
+// to nothing at the edges of the visible range; mirrors str::shift()
+float spectrum(vec3 color, float lambda) {
+  if (lambda <= VISIBLE.x || lambda >= VISIBLE.y) {
+    return 0.0;
+  }
+
+  if (lambda <= WAVELENGTHS.b) {
+    return color.b * (lambda - VISIBLE.x) / (WAVELENGTHS.b - VISIBLE.x);
+  }
+
+  if (lambda <= WAVELENGTHS.g) {
+    return mix(color.b, color.g, (lambda - WAVELENGTHS.b) / (WAVELENGTHS.g - WAVELENGTHS.b));
+  }
+
+  if (lambda <= WAVELENGTHS.r) {
+    return mix(color.g, color.r, (lambda - WAVELENGTHS.g) / (WAVELENGTHS.r - WAVELENGTHS.g));
+  }
+
+  return color.r * (VISIBLE.y - lambda) / (VISIBLE.y - WAVELENGTHS.r);
+}
+
+// Doppler shift by the factor d, each channel read where it was emitted, with D^3 beaming
+vec3 shift(vec3 color, float d) {
+  vec3 lambda = d * WAVELENGTHS;
+  return d * d * d * vec3(spectrum(color, lambda.r), spectrum(color, lambda.g), spectrum(color, lambda.b));
+}
+
+// a moving sphere is intersected in its rest frame, where the ray is still a straight line
+// through the boosted events (origin - position, time) and (dir, -1) per unit of t; only those
+// fetch their Boost
+HitInfo RaySphere(Object object, uint slot, Ray ray) {
+  vec3 O = ray.origin - object.sphere.xyz;
+  vec3 D = ray.dir;
+  float R = object.sphere.w;
+
+  bool moving = (object.flags & STR_OBJECT_MOVING) != 0u;
+  Boost boost;
+
+  if (moving) {
+    boost = motion.boosts[slot];
+    O = (boost.matrix * vec4(O, ray.time)).xyz;
+    D = (boost.matrix * vec4(ray.dir, -1.0)).xyz;
+  }
+
+  float a = dot(D, D);
+  float b = dot(O, D);
+  float c = dot(O, O) - R * R;
+  float disc = b * b - a * c;
+
+  if (disc < 0) {
+    return HitInfo(
+      false,
+      false,
+      0.0,
+      vec3(0.0, 0.0, 0.0),
+      vec3(0.0, 0.0, 0.0),
+      vec3(0.0, 0.0, 0.0)
+    );
+  }
+
+  float t = -(b + sqrt(disc)) / a;
+
+  // light older than the horizon is outside the object's bounds in the BVH
+  if (moving && ray.time - t < -HORIZON) {
+    return HitInfo(
+      false,
+      false,
+      0.0,
+      vec3(0.0, 0.0, 0.0),
+      vec3(0.0, 0.0, 0.0),
+      vec3(0.0, 0.0, 0.0)
+    );
+  }
+
+  vec3 P = ray.origin + t * ray.dir;
+  vec3 N = O + t * D;
+  vec3 color = unpackUnorm4x8(object.color).rgb;
+
+  // the rest frame normal, carried back through the length contraction, and the Doppler factor
+  // for light leaving the object against the ray
+  if (moving) {
+    N = mat3(boost.matrix) * N;
+    color = shift(color, 1.0 / (boost.motion.w * (1.0 + dot(boost.motion.xyz, ray.dir))));
+  }
+
+  return HitInfo(
+    true,
+    false,
+    t,
+    P,
+    normalize(N),
+    color
+  );
+}
+
+float RayBox(BVHNode node, Ray ray, vec3 invDir, float tMax) {
+  vec3 t0 = (node.lo - ray.origin) * invDir;
+  vec3 t1 = (node.hi - ray.origin) * invDir;
+  vec3 tNear = min(t0, t1);
+  vec3 tFar = max(t0, t1);
+
+  float tEnter = max(max(tNear.x, tNear.y), max(tNear.z, 0.0));
+  float tExit = min(min(tFar.x, tFar.y), min(tFar.z, tMax));
+
+  return tEnter <= tExit ? tEnter : inf;
+}
+
+// the nearest sphere along the ray closer than tMax
+HitInfo intersect(Ray ray, float tMax) {
+  HitInfo hit = HitInfo(
+    false,
+    false,
+    tMax,
+    vec3(0.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 0.0)
+  );
+
+  vec3 invDir = 1.0 / ray.dir;
+  if (ssbo.size == 0 || RayBox(bvh.nodes[0], ray, invDir, hit.t) == inf) {
+    hit.t = inf;
+    return hit;
+  }
+
+  uint stack[STACK_SIZE];
+  uint sp = 0;
+  uint index = 0;
+
+  while (true) {
+    BVHNode node = bvh.nodes[index];
+
+    if (node.count > 0) {
+      for (uint i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+        uint slot = bvhIndices.indices[i];
+        HitInfo info = RaySphere(ssbo.objects[slot], slot, ray);
+
+        if (info.hit && info.t > EPSILON && info.t < hit.t) {
+          hit = info;
+        }
+      }
+
+      if (sp == 0) break;
+      index = stack[--sp];
+      continue;
+    }
+
+    uint closer = node.leftFirst;
+    uint farther = node.leftFirst + 1;
+    float tNear = RayBox(bvh.nodes[closer], ray, invDir, hit.t);
+    float tFar = RayBox(bvh.nodes[farther], ray, invDir, hit.t);
+
+    if (tFar < tNear) {
+      uint child = closer; closer = farther; farther = child;
+      float t = tNear; tNear = tFar; tFar = t;
+    }
+
+    if (tNear == inf) {
+      if (sp == 0) break;
+      index = stack[--sp];
+      continue;
+    }
+
+    index = closer;
+    if (tFar != inf && sp < STACK_SIZE) {
+      stack[sp++] = farther;
+    }
+  }
+
+  if (!hit.hit) {
+    hit.t = inf;
+  }
+
+  return hit;
+}
+
+// x'' = -3/2 rs h^2 x / r^5 with h = |x x v|, the null geodesics of each Schwarzschild mass superposed
+vec3 bend(vec3 x, vec3 v) {
+  vec3 a = vec3(0.0, 0.0, 0.0);
+
+  for (uint i = 0; i < spacetime.count; ++i) {
+    vec3 d = x - spacetime.lenses[i].xyz;
+    vec3 h = cross(d, v);
+
+    float r2 = dot(d, d);
+    float rs = 2.0 * spacetime.lenses[i].w;
+
+    a -= 1.5 * rs * dot(h, h) / (r2 * r2 * sqrt(r2)) * d;
+  }
+
+  return a;
+}
+
+// one Dormand-Prince 5(4) step of size h from (x, v), whose derivative k1 carries over from the
+// previous step; returns the error relative to the tolerances, acceptable when at most 1
+float dormandPrince(vec3 x, vec3 v, vec3 k1, float h, out vec3 nextX, out vec3 nextV, out vec3 k7) {
+  vec3 v1 = v;
+
+  vec3 v2 = v + h * (1.0 / 5 * k1);
+  vec3 x2 = x + h * (1.0 / 5 * v1);
+  vec3 k2 = bend(x2, v2);
+
+  vec3 v3 = v + h * (3.0 / 40 * k1 + 9.0 / 40 * k2);
+  vec3 x3 = x + h * (3.0 / 40 * v1 + 9.0 / 40 * v2);
+  vec3 k3 = bend(x3, v3);
+
+  vec3 v4 = v + h * (44.0 / 45 * k1 - 56.0 / 15 * k2 + 32.0 / 9 * k3);
+  vec3 x4 = x + h * (44.0 / 45 * v1 - 56.0 / 15 * v2 + 32.0 / 9 * v3);
+  vec3 k4 = bend(x4, v4);
+
+  vec3 v5 = v + h * (19372.0 / 6561 * k1 - 25360.0 / 2187 * k2 + 64448.0 / 6561 * k3 - 212.0 / 729 * k4);
+  vec3 x5 = x + h * (19372.0 / 6561 * v1 - 25360.0 / 2187 * v2 + 64448.0 / 6561 * v3 - 212.0 / 729 * v4);
+  vec3 k5 = bend(x5, v5);
+
+  vec3 v6 = v + h * (9017.0 / 3168 * k1 - 355.0 / 33 * k2 + 46732.0 / 5247 * k3 + 49.0 / 176 * k4 - 5103.0 / 18656 * k5);
+  vec3 x6 = x + h * (9017.0 / 3168 * v1 - 355.0 / 33 * v2 + 46732.0 / 5247 * v3 + 49.0 / 176 * v4 - 5103.0 / 18656 * v5);
+  vec3 k6 = bend(x6, v6);
+
+  nextX = x + h * (35.0 / 384 * v1 + 500.0 / 1113 * v3 + 125.0 / 192 * v4 - 2187.0 / 6784 * v5 + 11.0 / 84 * v6);
+  nextV = v + h * (35.0 / 384 * k1 + 500.0 / 1113 * k3 + 125.0 / 192 * k4 - 2187.0 / 6784 * k5 + 11.0 / 84 * k6);
+  k7 = bend(nextX, nextV);
+
+  vec3 ex = h * (71.0 / 57600 * v1 - 71.0 / 16695 * v3 + 71.0 / 1920 * v4 - 17253.0 / 339200 * v5 + 22.0 / 525 * v6 - 1.0 / 40 * nextV);
+  vec3 ev = h * (71.0 / 57600 * k1 - 71.0 / 16695 * k3 + 71.0 / 1920 * k4 - 17253.0 / 339200 * k5 + 22.0 / 525 * k6 - 1.0 / 40 * k7);
+
+  float speed = length(v);
+  float position = length(ex) / (spacetime.absolute + spacetime.relative * h * speed);
+  float direction = length(ev) / (spacetime.absolute + spacetime.relative * speed);
+
+  return max(position, direction);
+}
+
+float nearestLens(vec3 x) {
+  float nearest = inf;
+
+  for (uint i = 0; i < spacetime.count; ++i) {
+    nearest = min(nearest, distance(x, spacetime.lenses[i].xyz));
+  }
+
+  return nearest;
+}
+
+bool captured(vec3 x) {
+  for (uint i = 0; i < spacetime.count; ++i) {
+    if (distance(x, spacetime.lenses[i].xyz) < 2.0 * spacetime.lenses[i].w) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// far from every mass and moving away from all of them, the rest of the path is a straight line
+bool escaped(vec3 x, vec3 v) {
+  for (uint i = 0; i < spacetime.count; ++i) {
+    vec3 d = x - spacetime.lenses[i].xyz;
+
+    if (dot(d, v) < 0.0 || length(d) < spacetime.escape * 2.0 * spacetime.lenses[i].w) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// bilinear lookup at u = rs / b and w = rs / r0, mirroring LensingTable::sample()
+vec2 deflection(float u, float w) {
+  float s = 1.0 - sqrt(max(1.0 - u / CRITICAL_IMPACT, 0.0));
+  float x = clamp(s * float(lensing.impact), 0.0, float(lensing.impact - 1));
+  float y = clamp(w / lensing.reach * float(lensing.distance - 1), 0.0, float(lensing.distance - 1));
+
+  uint x0 = uint(x);
+  uint y0 = uint(y);
+  uint x1 = min(x0 + 1, lensing.impact - 1);
+  uint y1 = min(y0 + 1, lensing.distance - 1);
+
+  vec2 bottom = mix(lensing.deflections[y0 * lensing.impact + x0], lensing.deflections[y0 * lensing.impact + x1], fract(x));
+  vec2 top = mix(lensing.deflections[y1 * lensing.impact + x0], lensing.deflections[y1 * lensing.impact + x1], fract(x));
+
+  return mix(bottom, top, fract(y));
+}
+
+// treats every mass ahead of the ray as a thin lens: the ray runs straight to its closest
+// approach, then turns towards the mass by the tabulated angle; one lookup counts as one step
+HitInfo deflect(inout Ray ray) {
+  uint passed = 0;
+
+  for (uint pass = 0; pass < spacetime.count; ++pass) {
+    uint next = MAX_LENSES;
+    float tNext = inf;
+
+    for (uint i = 0; i < spacetime.count; ++i) {
+      float t = dot(spacetime.lenses[i].xyz - ray.origin, ray.dir);
+
+      if ((passed & (1u << i)) == 0 && t > 0.0 && t < tNext) {
+        next = i;
+        tNext = t;
+      }
+    }
+
+    if (next == MAX_LENSES) break;
+    ++traceSteps;
+
+    HitInfo hit = intersect(ray, tNext);
+    if (hit.hit) {
+      return hit;
+    }
+
+    vec3 lens = spacetime.lenses[next].xyz;
+    float rs = 2.0 * spacetime.lenses[next].w;
+
+    vec3 closest = ray.origin + tNext * ray.dir;
+    vec3 toward = lens - closest;
+    float b = length(toward);
+
+    if (rs >= CRITICAL_IMPACT * b) {
+      return HitInfo(true, true, tNext, closest, vec3(0.0, 0.0, 0.0), vec3(0.0, 0.0, 0.0));
+    }
+
+    float angle = deflection(rs / b, rs / distance(ray.origin, lens)).x;
+
+    ray.origin = closest;
+    ray.time -= tNext;
+    ray.dir = normalize(cos(angle) * ray.dir + sin(angle) * toward / b);
+    passed |= 1u << next;
+  }
+
+  return intersect(ray, inf);
+}
+
+// follows the ray's geodesic with adaptive steps, testing each accepted step as a straight
+// segment; mirrors Tracer::propagate(), and counts attempted steps into traceSteps
+HitInfo propagate(inout Ray ray) {
+  if (spacetime.count == 0) {
+    return intersect(ray, inf);
+  }
+
+  if (spacetime.bending == BENDING_LOOKUP && lensing.impact > 0) {
+    return deflect(ray);
+  }
+
+  vec3 x = ray.origin;
+  vec3 v = ray.dir;
+  vec3 k1 = bend(x, v);
+
+  float h = 0.1 * nearestLens(x);
+  float travelled = 0.0;
+  float start = ray.time;
+
+  for (uint i = 0; i < spacetime.steps && travelled < spacetime.distance; ++i) {
+    ++traceSteps;
+
+    // a step no longer than the distance to the nearest mass can not jump over it
+    h = min(h, 0.5 * nearestLens(x));
+
+    vec3 nextX;
+    vec3 nextV;
+    vec3 k7;
+    float error = dormandPrince(x, v, k1, h, nextX, nextV, k7);
+
+    float scale = clamp(0.9 * pow(max(error, 1e-10), -0.2), 0.2, 5.0);
+
+    if (error > 1.0) {
+      h *= scale;
+      continue;
+    }
+
+    vec3 segment = nextX - x;
+    float len = length(segment);
+
+    ray.origin = x;
+    ray.dir = segment / len;
+    ray.time = start - travelled;
+
+    HitInfo hit = intersect(ray, len);
+    if (hit.hit) {
+      return hit;
+    }
+
+    x = nextX;
+    v = nextV;
+    k1 = k7;
+    travelled += len;
+    h *= scale;
+
+    if (captured(x)) {
+      return HitInfo(true, true, travelled, x, vec3(0.0, 0.0, 0.0), vec3(0.0, 0.0, 0.0));
+    }
+
+    if (escaped(x, v)) {
+      break;
+    }
+  }
+
+  ray.origin = x;
+  ray.dir = normalize(v);
+  ray.time = start - travelled;
+
+  return intersect(ray, inf);
+}
+
+// the ray through a point of the image, in pixels from its first corner
+Ray cameraRay(vec2 position) {
+  vec3 target = frame.corner + position.x * frame.dx + position.y * frame.dy;
+
+  return Ray(
+    frame.origin,
+    normalize(target - frame.origin),
+    vec3(0.0, 0.0, 0.0),
+    0.0
+  );
+}
+
+Ray trace(Ray ray) {
+  for (uint i = 0; i < MAX_BOUNCES; ++i) {
+    HitInfo hit = propagate(ray);
+
+    // inside a horizon nothing comes back
+    if (hit.absorbed) {
+      return ray;
+    }
+
+    if (!hit.hit) {
+      float a = abs(dot(ray.dir, vec3(0.0, -1.0, 0.0)));
+      ray.color += (1 - a) * SKY_LIGHT + a * SKY_DARK;
+      return ray;
+    }
+
+    ray.color += abs(dot(ray.dir, hit.normal)) * hit.color;
+    ray.origin = hit.point;
+    ray.time -= hit.t;
+
+    float alignment = dot(ray.dir, hit.normal);
+    int invert = int(alignment / abs(alignment));
+
+    ray.dir = invert * (ray.dir - 2 * alignment * hit.normal);
+  }
+
+  return ray;
+}
+
+// one atomic per ray, and only while there are masses to integrate around
+void countSteps() {
+  if (spacetime.count > 0) {
+    atomicAdd(counters.rays, 1u);
+    atomicAdd(counters.steps, traceSteps);
+  }
+}
+
+void seedRandom(ivec2 pixel, uint seed) {
+  rngState = pcg(uint(pixel.x) ^ pcg(uint(pixel.y) ^ pcg(seed)));
+}
+
+// running average of every sample since the last reset, kept in the accumulation image
+vec3 accumulate(ivec2 pixel, vec3 color, uint index) {
+  if (any(greaterThanEqual(pixel, imageSize(accumulation)))) {
+    return color;
+  }
+
+  if (index > 0) {
+    color = mix(imageLoad(accumulation, pixel).rgb, color, 1.0 / float(index + 1));
+  }
+
+  imageStore(accumulation, pixel, vec4(color, 1.0));
+  return color;
+}
+
+#endif
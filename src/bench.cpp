@@ -0,0 +1,152 @@
+#include "src/include/bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace str
+{
+
+Bench::Bench(unsigned long w, unsigned long r) : warmup(w), reps(std::max(r, 1ul))
+{
+}
+
+void Bench::setFilter(const std::string& f)
+{
+  filter = f;
+}
+
+void Bench::setLog(std::ostream * out)
+{
+  log = out;
+
+  if (log)
+    header(*log);
+}
+
+bool Bench::enabled(const std::string& name) const
+{
+  return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+const std::vector<BenchResult>& Bench::results() const
+{
+  return result_array;
+}
+
+void Bench::report(std::ostream& out) const
+{
+  header(out);
+
+  for (const auto& result : result_array)
+    row(out, result);
+}
+
+void Bench::writeCSV(std::ostream& out) const
+{
+  out << "name,objects,threads,ops,reps,mean_ms,stddev_ms,min_ms,median_ms,max_ms,ns_per_op,ops_per_s\n";
+
+  for (const auto& r : result_array)
+  {
+    out << r.name << "," << r.objects << "," << r.threads << "," << r.ops << "," << r.reps << ","
+        << r.mean_ms << "," << r.stddev_ms << "," << r.min_ms << "," << r.median_ms << "," << r.max_ms << ","
+        << r.nsPerOp() << "," << r.opsPerSecond() << "\n";
+  }
+}
+
+void Bench::writeJSON(std::ostream& out) const
+{
+  out << "[\n";
+
+  for (unsigned long i = 0; i < result_array.size(); ++i)
+  {
+    const BenchResult& r = result_array[i];
+
+    out << "  { \"name\": \"" << r.name << "\", \"objects\": " << r.objects << ", \"threads\": " << r.threads
+        << ", \"ops\": " << r.ops << ", \"reps\": " << r.reps
+        << ", \"mean_ms\": " << r.mean_ms << ", \"stddev_ms\": " << r.stddev_ms << ", \"min_ms\": " << r.min_ms
+        << ", \"median_ms\": " << r.median_ms << ", \"max_ms\": " << r.max_ms
+        << ", \"ns_per_op\": " << r.nsPerOp() << ", \"ops_per_s\": " << r.opsPerSecond() << " }"
+        << (i + 1 < result_array.size() ? ",\n" : "\n");
+  }
+
+  out << "]\n";
+}
+
+void Bench::write(const std::string& path) const
+{
+  std::ofstream file(path);
+
+  if (!file.is_open())
+    throw std::runtime_error("error @ str::Bench::write() : could not open " + path);
+
+  if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+    writeJSON(file);
+  else
+    writeCSV(file);
+}
+
+BenchResult Bench::summarize(
+  const std::string& name,
+  unsigned long objects,
+  unsigned int threads,
+  unsigned long ops,
+  std::vector<float>& times
+) const
+{
+  std::sort(times.begin(), times.end());
+
+  float sum = 0.0f;
+  for (float t : times)
+    sum += t;
+
+  float mean = sum / times.size();
+
+  float variance = 0.0f;
+  for (float t : times)
+    variance += (t - mean) * (t - mean);
+
+  unsigned long mid = times.size() / 2;
+  float median = times.size() % 2 ? times[mid] : (times[mid - 1] + times[mid]) / 2;
+
+  return BenchResult{
+    .name       = name,
+    .objects    = objects,
+    .threads    = threads,
+    .ops        = ops,
+    .reps       = times.size(),
+    .mean_ms    = mean,
+    .stddev_ms  = times.size() > 1 ? std::sqrt(variance / (times.size() - 1)) : 0.0f,
+    .min_ms     = times.front(),
+    .median_ms  = median,
+    .max_ms     = times.back()
+  };
+}
+
+void Bench::add(const BenchResult& result)
+{
+  result_array.push_back(result);
+
+  if (log)
+    row(*log, result);
+}
+
+void Bench::header(std::ostream& out) const
+{
+  out << std::left << std::setw(24) << "benchmark" << std::right
+      << std::setw(9) << "objects" << std::setw(8) << "threads"
+      << std::setw(12) << "median ms" << std::setw(10) << "+- ms" << std::setw(12) << "ns/op" << std::setw(14) << "ops/s" << "\n";
+}
+
+void Bench::row(std::ostream& out, const BenchResult& r) const
+{
+  out << std::fixed << std::setprecision(3);
+  out << std::left << std::setw(24) << r.name << std::right
+      << std::setw(9) << r.objects << std::setw(8) << r.threads
+      << std::setw(12) << r.median_ms << std::setw(10) << r.stddev_ms << std::setw(12) << r.nsPerOp()
+      << std::setw(14) << std::setprecision(0) << r.opsPerSecond() << "\n";
+}
+
+} // namespace str
@@ -0,0 +1,291 @@
+#include "src/include/bench.hpp"
+#include "src/include/bvh.hpp"
+#include "src/include/scene.hpp"
+#include "src/include/tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// GPU-free microbenchmarks and scaling runs over the math, packing and CPU tracing kernels:
+//   str_bench [--filter <substring>] [--warmup <n>] [--reps <n>] [--max-objects <n>] [--out <path.csv|path.json>]
+
+#define STR_BENCH_OPS 4096
+#define STR_BENCH_WIDTH 320
+#define STR_BENCH_HEIGHT 180
+#define STR_BENCH_THREAD_OBJECTS 10000
+
+// the default Camera's view and near plane, without pulling in the Vulkan side of Camera
+static la::mat<4> benchView()
+{
+  return la::mat<4>::view_matrix({ 0.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 }, { 0.0, -1.0, 0.0 });
+}
+
+static la::vec<3> benchNearPlane()
+{
+  float np = 0.1f;
+  float height = 2 * np * tanf(la::radians(60.0f) / 2);
+  return { static_cast<float>(STR_BENCH_WIDTH) / STR_BENCH_HEIGHT * height, height, np };
+}
+
+static std::vector<la::mat<4>> matrices(unsigned long count)
+{
+  std::vector<la::mat<4>> result;
+  result.reserve(count);
+
+  for (unsigned long i = 0; i < count; ++i)
+  {
+    str::Transform t;
+    t.translate(1.0f + i, { 1.0, 2.0, 3.0 }).rotate({ 0.1f * i, 0.2f, 0.3f }).scale({ 0.5, 0.5, 0.5 });
+    result.push_back(t.model());
+  }
+
+  return result;
+}
+
+static std::vector<la::vec<3>> vectors(unsigned long count)
+{
+  std::vector<la::vec<3>> result;
+  result.reserve(count);
+
+  for (unsigned long i = 0; i < count; ++i)
+    result.push_back({ 1.0f + i, 0.5f * i, 2.0f - i });
+
+  return result;
+}
+
+static void micro(str::Bench& bench)
+{
+  auto mats = matrices(STR_BENCH_OPS);
+  auto vecs = vectors(STR_BENCH_OPS);
+  std::vector<la::mat<4>> mat_out(STR_BENCH_OPS);
+  std::vector<la::vec<4>> vec_out(STR_BENCH_OPS);
+  std::vector<la::vec<3>> vec3_out(STR_BENCH_OPS);
+
+  bench.run("la/mat4*mat4", 0, 1, STR_BENCH_OPS, [&]() {
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      mat_out[i] = mats[i] * mats[STR_BENCH_OPS - 1 - i];
+    str::keep(mat_out);
+  });
+
+  bench.run("la/mat4*vec4", 0, 1, STR_BENCH_OPS, [&]() {
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      vec_out[i] = mats[i] * la::vec<4>{ vecs[i][0], vecs[i][1], vecs[i][2], 1.0f };
+    str::keep(vec_out);
+  });
+
+  bench.run("la/mat4.inverse", 0, 1, STR_BENCH_OPS, [&]() {
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      mat_out[i] = mats[i].inverse();
+    str::keep(mat_out);
+  });
+
+  bench.run("la/vec3.dot", 0, 1, STR_BENCH_OPS, [&]() {
+    float sum = 0.0f;
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      sum += vecs[i] * vecs[STR_BENCH_OPS - 1 - i];
+    str::keep(sum);
+  });
+
+  bench.run("la/vec3.cross", 0, 1, STR_BENCH_OPS, [&]() {
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      vec3_out[i] = vecs[i] % vecs[STR_BENCH_OPS - 1 - i];
+    str::keep(vec3_out);
+  });
+
+  bench.run("la/vec3.normalized", 0, 1, STR_BENCH_OPS, [&]() {
+    for (unsigned long i = 0; i < STR_BENCH_OPS; ++i)
+      vec3_out[i] = vecs[i].normalized();
+    str::keep(vec3_out);
+  });
+
+  // rotating first marks the cached matrices dirty, so every model() call rebuilds
+  std::vector<str::Transform> transforms = str::gridScene(STR_BENCH_OPS);
+  bench.run("transform/model", 0, 1, STR_BENCH_OPS, [&]() {
+    for (auto& t : transforms)
+      str::keep(t.rotate({ 0.001f, 0.0, 0.0 }).model());
+  });
+}
+
+static void objects(str::Bench& bench, const std::vector<unsigned long>& counts)
+{
+  la::mat<4> view = benchView();
+  la::vec<3> npDims = benchNearPlane();
+
+  str::Framebuffer framebuffer;
+  framebuffer.resize(STR_BENCH_WIDTH, STR_BENCH_HEIGHT);
+  unsigned long pixels = STR_BENCH_WIDTH * STR_BENCH_HEIGHT;
+
+  str::JobSystem jobs(1);
+  str::Tracer tracer(jobs);
+
+  for (unsigned long count : counts)
+  {
+    str::TransformStore store;
+    unsigned long e_id = 1;
+    for (const auto& object : str::gridScene(count))
+      store.insert(e_id++, object);
+
+    // the same packing Camera::updateSSBO does into the mapped storage buffer
+    std::vector<str::ObjectData> packed(count);
+    bench.run("store/pack", count, 1, count, [&]() {
+      store.pack(packed.data());
+      str::keep(packed);
+    });
+
+    // the per-object boosts Camera::updateSSBO derives alongside the packing, with every object
+    // moving so none takes the early out for objects at rest
+    str::TransformStore moving;
+    e_id = 1;
+    for (auto object : str::gridScene(count))
+      moving.insert(e_id++, object.velocity({ 0.5, 0.0, 0.1 }));
+
+    std::vector<str::Boost> boosted(count);
+    bench.run("store/boost", count, 1, count, [&]() {
+      str::computeBoosts(moving, boosted.data(), 0, count);
+      str::keep(boosted);
+    });
+
+    bench.run("store/translate", count, 1, count, [&]() {
+      store.translate(0, count, 0.001f, { 1.0, 0.0, 0.0 });
+    });
+
+    str::BVH bvh;
+    bench.run("bvh/build", count, 1, count, [&]() {
+      bvh.build(store);
+    });
+
+    bench.run("bvh/refit", count, 1, count, [&]() {
+      bvh.refit(store);
+    });
+
+    bvh.build(store);
+    bench.run("trace/objects", count, 1, pixels, [&]() {
+      tracer.render(framebuffer, view, npDims, store, bvh);
+    });
+  }
+}
+
+static void threads(str::Bench& bench, unsigned long count)
+{
+  la::mat<4> view = benchView();
+  la::vec<3> npDims = benchNearPlane();
+
+  str::Framebuffer framebuffer;
+  framebuffer.resize(STR_BENCH_WIDTH, STR_BENCH_HEIGHT);
+  unsigned long pixels = STR_BENCH_WIDTH * STR_BENCH_HEIGHT;
+
+  str::TransformStore store;
+  unsigned long e_id = 1;
+  for (const auto& object : str::gridScene(count))
+    store.insert(e_id++, object);
+
+  str::BVH bvh;
+  bvh.build(store);
+
+  unsigned int hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::vector<unsigned int> counts;
+  for (unsigned int n = 1; n < hardware; n *= 2)
+    counts.push_back(n);
+  counts.push_back(hardware);
+
+  for (unsigned int n : counts)
+  {
+    str::JobSystem jobs(n);
+    str::Tracer tracer(jobs);
+
+    bench.run("trace/threads", count, n, pixels, [&]() {
+      tracer.render(framebuffer, view, npDims, store, bvh);
+    });
+  }
+}
+
+// the adaptive geodesic integrator around a single mass, from loose to tight tolerances, against
+// the table lookups that replace it
+static void lensing(str::Bench& bench)
+{
+  la::mat<4> view = benchView();
+  la::vec<3> npDims = benchNearPlane();
+
+  str::Framebuffer framebuffer;
+  framebuffer.resize(STR_BENCH_WIDTH, STR_BENCH_HEIGHT);
+  unsigned long pixels = STR_BENCH_WIDTH * STR_BENCH_HEIGHT;
+
+  str::TransformStore store;
+  unsigned long e_id = 1;
+  for (const auto& object : str::lensScene())
+    store.insert(e_id++, object);
+
+  str::BVH bvh;
+  bvh.build(store);
+
+  str::JobSystem jobs(1);
+  str::Tracer tracer(jobs);
+
+  for (std::string tolerance : { "1e-3", "1e-4", "1e-5" })
+  {
+    tracer.setTolerances(str::Tolerances{ .relative = std::stof(tolerance) });
+
+    bench.run("trace/lensed/" + tolerance, store.size(), 1, pixels, [&]() {
+      tracer.render(framebuffer, view, npDims, store, bvh);
+    });
+  }
+
+  str::LensingTable lensing;
+  lensing.load(str::Tolerances{}, jobs);
+  tracer.setTolerances(str::Tolerances{});
+  tracer.setLensing(&lensing);
+
+  bench.run("trace/lensed/lookup", store.size(), 1, pixels, [&]() {
+    tracer.render(framebuffer, view, npDims, store, bvh);
+  });
+}
+
+static std::string option(std::vector<std::string>& args, const std::string& name, const std::string& fallback)
+{
+  auto it = std::find(args.begin(), args.end(), name);
+  if (it == args.end() || it + 1 == args.end())
+    return fallback;
+
+  std::string value = *(it + 1);
+  args.erase(it, it + 2);
+  return value;
+}
+
+int main(int argc, char ** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+
+  std::string filter = option(args, "--filter", "");
+  std::string out = option(args, "--out", "");
+  unsigned long warmup = std::stoul(option(args, "--warmup", std::to_string(STR_BENCH_WARMUP)));
+  unsigned long reps = std::stoul(option(args, "--reps", std::to_string(STR_BENCH_REPS)));
+  unsigned long max_objects = std::stoul(option(args, "--max-objects", "100000"));
+
+  if (!args.empty())
+  {
+    std::cerr << "usage: str_bench [--filter <substring>] [--warmup <n>] [--reps <n>] [--max-objects <n>] [--out <path>]\n";
+    return 1;
+  }
+
+  str::Bench bench(warmup, reps);
+  bench.setFilter(filter);
+  bench.setLog(&std::cout);
+
+  std::vector<unsigned long> counts;
+  for (unsigned long n = 1; n <= max_objects; n *= 10)
+    counts.push_back(n);
+
+  micro(bench);
+  objects(bench, counts);
+  threads(bench, std::min(max_objects, static_cast<unsigned long>(STR_BENCH_THREAD_OBJECTS)));
+  lensing(bench);
+
+  if (!out.empty())
+    bench.write(out);
+
+  return 0;
+}
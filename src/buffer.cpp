@@ -0,0 +1,260 @@
+#include "src/include/buffer.hpp"
+
+#include <cstring>
+
+namespace str
+{
+
+unsigned int findMemoryIndex(
+  const vk::raii::PhysicalDevice& vk_physicalDevice,
+  unsigned int filter,
+  vk::MemoryPropertyFlags flags
+)
+{
+  auto properties = vk_physicalDevice.getMemoryProperties();
+
+  for (unsigned long i = 0; i < properties.memoryTypeCount; ++i)
+  {
+    if ((filter & (1 << i)) &&
+        (properties.memoryTypes[i].propertyFlags & flags) == flags)
+    {
+      return i;
+    }
+  }
+
+  throw std::runtime_error("error @ str::findMemoryIndex() : could not find suitable memory index");
+}
+
+bool hasSeparateHeap(const vk::raii::PhysicalDevice& vk_physicalDevice)
+{
+  auto properties = vk_physicalDevice.getMemoryProperties();
+
+  bool device = false;
+  bool host = false;
+  for (unsigned long i = 0; i < properties.memoryHeapCount; ++i)
+  {
+    if (properties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal)
+      device = true;
+    else
+      host = true;
+  }
+
+  return device && host;
+}
+
+void createBuffer(
+  const Device& device,
+  vk::DeviceSize size,
+  vk::BufferUsageFlags usage,
+  vk::MemoryPropertyFlags flags,
+  vk::raii::Buffer& vk_buffer,
+  vk::raii::DeviceMemory& vk_memory
+)
+{
+  vk::BufferCreateInfo ci_buffer{
+    .size         = size,
+    .usage        = usage,
+    .sharingMode  = vk::SharingMode::eExclusive
+  };
+
+  vk_buffer = device.logical().createBuffer(ci_buffer);
+  auto requirements = vk_buffer.getMemoryRequirements();
+
+  vk::MemoryAllocateInfo ai_memory{
+    .allocationSize   = requirements.size,
+    .memoryTypeIndex  = findMemoryIndex(device.physical(), requirements.memoryTypeBits, flags)
+  };
+
+  vk_memory = device.logical().allocateMemory(ai_memory);
+  vk_buffer.bindMemory(*vk_memory, 0);
+}
+
+void submitImmediate(
+  const Device& device,
+  const std::function<void(const vk::raii::CommandBuffer&)>& record
+)
+{
+  vk::CommandPoolCreateInfo ci_commandPool{
+    .flags            = vk::CommandPoolCreateFlagBits::eTransient,
+    .queueFamilyIndex = device.familyIndex()
+  };
+  vk::raii::CommandPool vk_commandPool = device.logical().createCommandPool(ci_commandPool);
+
+  vk::CommandBufferAllocateInfo ai_commandBuffer{
+    .commandPool        = *vk_commandPool,
+    .level              = vk::CommandBufferLevel::ePrimary,
+    .commandBufferCount = 1
+  };
+  vk::raii::CommandBuffers vk_commandBuffers(device.logical(), ai_commandBuffer);
+
+  vk::CommandBufferBeginInfo beginInfo{
+    .flags  = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  };
+
+  vk_commandBuffers[0].begin(beginInfo);
+  record(vk_commandBuffers[0]);
+  vk_commandBuffers[0].end();
+
+  vk::raii::Fence vk_fence = device.logical().createFence(vk::FenceCreateInfo{});
+
+  vk::SubmitInfo submitInfo{
+    .commandBufferCount = 1,
+    .pCommandBuffers    = &*vk_commandBuffers[0]
+  };
+
+  device.queue().submit(submitInfo, *vk_fence);
+  static_cast<void>(device.logical().waitForFences(*vk_fence, vk::True, UINT64_MAX));
+}
+
+const vk::raii::Buffer& MappedBuffer::buffer() const
+{
+  return vk_buffer;
+}
+
+vk::DeviceSize MappedBuffer::size() const
+{
+  return bytes;
+}
+
+void * MappedBuffer::data() const
+{
+  return mapped;
+}
+
+// starts out zeroed, so a block the CPU has not written yet reads as empty
+void MappedBuffer::allocate(const Device& device, vk::DeviceSize size, vk::BufferUsageFlags usage)
+{
+  createBuffer(
+    device,
+    size,
+    usage,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+    vk_buffer,
+    vk_memory
+  );
+
+  bytes = size;
+  mapped = vk_memory.mapMemory(0, size);
+  std::memset(mapped, 0, size);
+}
+
+const vk::raii::Buffer& StorageBuffer::buffer() const
+{
+  return device_local ? vk_buffer : vk_staging;
+}
+
+vk::DeviceSize StorageBuffer::capacity() const
+{
+  return bytes;
+}
+
+void * StorageBuffer::data() const
+{
+  return mapped;
+}
+
+bool StorageBuffer::staged() const
+{
+  return device_local;
+}
+
+bool StorageBuffer::reserve(const Device& device, vk::DeviceSize size)
+{
+  if (size <= bytes) return false;
+
+  allocate(device, std::max(size, 2 * bytes));
+  return true;
+}
+
+void StorageBuffer::touch(vk::DeviceSize offset, vk::DeviceSize size)
+{
+  if (!device_local || size == 0) return;
+
+  if (dirty_begin == dirty_end)
+  {
+    dirty_begin = offset;
+    dirty_end = offset + size;
+    return;
+  }
+
+  dirty_begin = std::min(dirty_begin, offset);
+  dirty_end = std::max(dirty_end, offset + size);
+}
+
+void StorageBuffer::record(const vk::raii::CommandBuffer& vk_commandBuffer)
+{
+  if (!device_local || dirty_begin == dirty_end) return;
+
+  vk::BufferCopy region{
+    .srcOffset  = dirty_begin,
+    .dstOffset  = dirty_begin,
+    .size       = dirty_end - dirty_begin
+  };
+  vk_commandBuffer.copyBuffer(*vk_staging, *vk_buffer, region);
+
+  vk::BufferMemoryBarrier barrier{
+    .srcAccessMask        = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask        = vk::AccessFlagBits::eShaderRead,
+    .srcQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .dstQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .buffer               = *vk_buffer,
+    .offset               = region.dstOffset,
+    .size                 = region.size
+  };
+
+  // read by camera.frag or camera.comp, depending on the backend
+  vk_commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader,
+    vk::DependencyFlags(),
+    nullptr,
+    barrier,
+    nullptr
+  );
+
+  dirty_begin = dirty_end = 0;
+}
+
+void StorageBuffer::allocate(const Device& device, vk::DeviceSize size)
+{
+  if (bytes == 0)
+    device_local = hasSeparateHeap(device.physical());
+
+  vk::raii::Buffer staging = nullptr;
+  vk::raii::DeviceMemory stagingMemory = nullptr;
+
+  createBuffer(
+    device,
+    size,
+    device_local ? vk::BufferUsageFlagBits::eTransferSrc : vk::BufferUsageFlagBits::eStorageBuffer,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+    staging,
+    stagingMemory
+  );
+
+  void * memory_map = stagingMemory.mapMemory(0, vk::WholeSize);
+  if (mapped != nullptr)
+    memcpy(memory_map, mapped, bytes);
+
+  if (device_local)
+  {
+    createBuffer(
+      device,
+      size,
+      vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eDeviceLocal,
+      vk_buffer,
+      vk_memory
+    );
+  }
+
+  vk_staging = std::move(staging);
+  vk_stagingMemory = std::move(stagingMemory);
+
+  touch(0, bytes);
+
+  bytes = size;
+  mapped = memory_map;
+}
+
+} // namespace str
@@ -0,0 +1,209 @@
+#include "src/include/bvh.hpp"
+#include "src/include/relativity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace str
+{
+
+const std::vector<BVHNode>& BVH::nodes() const
+{
+  return node_array;
+}
+
+const std::vector<unsigned int>& BVH::indices() const
+{
+  return index_array;
+}
+
+void BVH::build(const TransformStore& transforms)
+{
+  node_array.clear();
+  index_array.resize(transforms.size());
+
+  for (unsigned int i = 0; i < index_array.size(); ++i)
+    index_array[i] = i;
+
+  if (index_array.empty())
+  {
+    built_area = 0.0f;
+    return;
+  }
+
+  node_array.reserve(2 * index_array.size());
+  node_array.emplace_back(BVHNode{ .left_first = 0, .count = static_cast<unsigned int>(index_array.size()) });
+
+  bound(node_array[0], transforms);
+  subdivide(0, transforms, 0);
+
+  built_area = area(node_array[0]);
+}
+
+void BVH::refit(const TransformStore& transforms)
+{
+  for (BVHNode& node : node_array)
+  {
+    if (node.count > 0)
+      bound(node, transforms);
+  }
+
+  merge();
+}
+
+// leaves only read the store, so they are bounded in parallel before the serial merge upwards
+void BVH::refit(const TransformStore& transforms, JobSystem& jobs)
+{
+  jobs.parallel_for(0, node_array.size(), STR_JOB_GRAIN / STR_BVH_LEAF_SIZE, [&](unsigned long first, unsigned long last) {
+    for (unsigned long i = first; i < last; ++i)
+    {
+      if (node_array[i].count > 0)
+        bound(node_array[i], transforms);
+    }
+  });
+
+  merge();
+}
+
+void BVH::update(const TransformStore& transforms)
+{
+  if (index_array.size() != transforms.size())
+  {
+    build(transforms);
+    return;
+  }
+
+  refit(transforms);
+
+  if (!node_array.empty() && area(node_array[0]) > STR_BVH_REBUILD_RATIO * built_area)
+    build(transforms);
+}
+
+void BVH::update(const TransformStore& transforms, JobSystem& jobs)
+{
+  if (index_array.size() != transforms.size())
+  {
+    build(transforms);
+    return;
+  }
+
+  refit(transforms, jobs);
+
+  if (!node_array.empty() && area(node_array[0]) > STR_BVH_REBUILD_RATIO * built_area)
+    build(transforms);
+}
+
+void BVH::bound(BVHNode& node, const TransformStore& transforms) const
+{
+  const auto& positions = transforms.positions();
+  const auto& sizes = transforms.sizes();
+  const auto& velocities = transforms.velocities();
+
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    node.lo[axis] = std::numeric_limits<float>::max();
+    node.hi[axis] = std::numeric_limits<float>::lowest();
+  }
+
+  for (unsigned int i = node.left_first; i < node.left_first + node.count; ++i)
+  {
+    const la::vec<3>& center = positions[index_array[i]];
+    float radius = std::fabs(sizes[index_array[i]][0]);
+
+    // a moving object is seen where it was when the light left it, anywhere on its path back
+    // to the horizon the shaders stop looking at
+    la::vec<3> trail = center - STR_RELATIVITY_HORIZON * velocities[index_array[i]];
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      node.lo[axis] = std::min(node.lo[axis], std::min(center[axis], trail[axis]) - radius);
+      node.hi[axis] = std::max(node.hi[axis], std::max(center[axis], trail[axis]) + radius);
+    }
+  }
+}
+
+// children are always appended after their parent, so walking backwards merges them bottom up
+void BVH::merge()
+{
+  for (unsigned long i = node_array.size(); i-- > 0;)
+  {
+    BVHNode& node = node_array[i];
+
+    if (node.count > 0)
+      continue;
+
+    const BVHNode& left = node_array[node.left_first];
+    const BVHNode& right = node_array[node.left_first + 1];
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      node.lo[axis] = std::min(left.lo[axis], right.lo[axis]);
+      node.hi[axis] = std::max(left.hi[axis], right.hi[axis]);
+    }
+  }
+}
+
+void BVH::subdivide(unsigned int index, const TransformStore& transforms, unsigned int depth)
+{
+  if (node_array[index].count <= STR_BVH_LEAF_SIZE) return;
+
+  // a deeper tree would overflow the traversal stacks and silently lose hits
+  if (depth >= STR_BVH_MAX_DEPTH)
+    throw std::runtime_error("error @ str::BVH::subdivide() : tree deeper than STR_BVH_MAX_DEPTH");
+
+  const auto& positions = transforms.positions();
+
+  unsigned int first = node_array[index].left_first;
+  unsigned int count = node_array[index].count;
+
+  la::vec<3> lo = positions[index_array[first]];
+  la::vec<3> hi = lo;
+  for (unsigned int i = first + 1; i < first + count; ++i)
+  {
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      lo[axis] = std::min(lo[axis], positions[index_array[i]][axis]);
+      hi[axis] = std::max(hi[axis], positions[index_array[i]][axis]);
+    }
+  }
+
+  la::vec<3> extent = hi - lo;
+  unsigned int axis = extent[0] > extent[1] ? (extent[0] > extent[2] ? 0 : 2) : (extent[1] > extent[2] ? 1 : 2);
+
+  // object median splits keep the tree balanced, so the depth is about log2(count / leaf size)
+  auto begin = index_array.begin() + first;
+  auto end = begin + count;
+  auto middle = begin + count / 2;
+
+  std::nth_element(begin, middle, end, [&](unsigned int a, unsigned int b){
+    return positions[a][axis] < positions[b][axis];
+  });
+
+  unsigned int left_count = static_cast<unsigned int>(middle - begin);
+  unsigned int left = static_cast<unsigned int>(node_array.size());
+
+  node_array.emplace_back(BVHNode{ .left_first = first, .count = left_count });
+  node_array.emplace_back(BVHNode{ .left_first = first + left_count, .count = count - left_count });
+
+  node_array[index].left_first = left;
+  node_array[index].count = 0;
+
+  bound(node_array[left], transforms);
+  bound(node_array[left + 1], transforms);
+
+  subdivide(left, transforms, depth + 1);
+  subdivide(left + 1, transforms, depth + 1);
+}
+
+float BVH::area(const BVHNode& node) const
+{
+  float x = node.hi[0] - node.lo[0];
+  float y = node.hi[1] - node.lo[1];
+  float z = node.hi[2] - node.lo[2];
+
+  return x * y + y * z + z * x;
+}
+
+} // namespace str
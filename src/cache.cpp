@@ -0,0 +1,35 @@
+#include "src/include/cache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+namespace str
+{
+
+// where the pipeline cache and lensing tables live between launches: $XDG_CACHE_HOME/str, else
+// ~/.cache/str, else the system's temporary directory. the directory is created on first use; if
+// that fails the save that follows reports the error
+std::string cachePath(const std::string& name)
+{
+  std::filesystem::path directory;
+
+  if (const char * xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+    directory = xdg;
+  else if (const char * home = std::getenv("HOME"); home && *home)
+    directory = std::filesystem::path(home) / ".cache";
+  else
+  {
+    std::error_code error;
+    directory = std::filesystem::temp_directory_path(error);
+  }
+
+  directory /= STR_CACHE_DIRECTORY;
+
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+
+  return (directory / name).string();
+}
+
+} // namespace str
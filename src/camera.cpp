@@ -1,6 +1,12 @@
 #include "src/include/camera.hpp"
 
-#include <fstream>
+#include "shaders/camera_comp.hpp"
+#include "shaders/camera_frag.hpp"
+#include "shaders/camera_vert.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 namespace str
 {
@@ -73,9 +79,43 @@ const vk::raii::Buffer& Camera::indexBuffer() const
   return vk_buffers[1];
 }
 
+const vk::raii::Pipeline& Camera::computePipeline() const
+{
+  return vk_computePipeline;
+}
+
+const vk::raii::PipelineLayout& Camera::computePipelineLayout() const
+{
+  return vk_computeLayout;
+}
+
+const std::array<unsigned int, 2>& Camera::workgroupSize() const
+{
+  return workgroup;
+}
+
+vk::Image Camera::accumulationImage() const
+{
+  return *vk_accumulation;
+}
+
+const vk::Extent2D& Camera::accumulationExtent() const
+{
+  return accumulation_extent;
+}
+
+// changes whenever something recorded into a command buffer does: the pipelines or a descriptor
+// set. the view reaches the shaders through the Frame uniform, so moving records nothing again
+unsigned long Camera::revision() const
+{
+  return changes;
+}
+
 void Camera::adjustNearPlane(float np)
 {
   npDims[2] = np;
+  stale = true;
+  resetSamples();
 }
 
 void Camera::adjustFOV(float fov)
@@ -84,12 +124,15 @@ void Camera::adjustFOV(float fov)
   float width = VECS_SETTINGS.aspect_ratio() * height;
   npDims[0] = width;
   npDims[1] = height;
+  stale = true;
+  resetSamples();
 };
 
 void Camera::translate(la::vec<3> displacement)
 {
-  la::vec<3> normal = { view[2][0], view[2][1], view[2][2] };
-  la::vec<3> position = { view[3][0], view[3][1], view[3][2] };
+  la::mat<4> inverse = view.inverse();
+  la::vec<3> normal = { inverse[2][0], inverse[2][1], inverse[2][2] };
+  la::vec<3> position = { inverse[3][0], inverse[3][1], inverse[3][2] };
   position = position + displacement;
 
   setView(position, normal);
@@ -97,8 +140,9 @@ void Camera::translate(la::vec<3> displacement)
 
 void Camera::rotate(la::vec<3> angles)
 {
-  la::vec<3> normal = { view[2][0], view[2][1], view[2][2] };
-  la::vec<3> position = { view[3][0], view[3][1], view[3][2] };
+  la::mat<4> inverse = view.inverse();
+  la::vec<3> normal = { inverse[2][0], inverse[2][1], inverse[2][2] };
+  la::vec<3> position = { inverse[3][0], inverse[3][1], inverse[3][2] };
 
   auto Rx = la::mat<4>::rotation_matrix(angles[0], { 1.0, 0.0, 0.0 });
   auto Ry = la::mat<4>::rotation_matrix(angles[1], { 0.0, -1.0, 0.0 });
@@ -110,61 +154,254 @@ void Camera::rotate(la::vec<3> angles)
   setView(position, normal);
 }
 
-void Camera::load(const vecs::Device& vecs_device, const vecs::GUI& vecs_gui)
+void Camera::resetSamples()
 {
-  loadPipeline(vecs_device, vecs_gui);
-  allocateUniforms(vecs_device);
-  loadDescriptors(vecs_device);
+  samples = 0;
 }
 
-void Camera::updateSSBO(unsigned int frame, const std::vector<Transform>& transforms)
+bool Camera::converged() const
 {
-  std::array<Transform, STR_MAX_TRANSFORMS> tforms;
+  return samples >= STR_MAX_SAMPLES;
+}
+
+FrameConstants Camera::nextFrame()
+{
+  if (stale)
+  {
+    basis = rayBasis(view, npDims, accumulation_extent.width, accumulation_extent.height);
+    stale = false;
+  }
+
+  // radical inverse in bases 2 and 3, so successive samples stratify the pixel
+  auto halton = [](unsigned int i, unsigned int base) {
+    float f = 1.0f;
+    float r = 0.0f;
 
-  for (unsigned int i = 0; i < transforms.size(); ++i)
-    tforms[i] = transforms[i];
+    for (; i > 0; i /= base)
+    {
+      f /= base;
+      r += f * (i % base);
+    }
 
-  TransformSSBO buffer{
-    .size       = static_cast<unsigned int>(transforms.size()),
-    .transforms = tforms
+    return r;
   };
 
-  void * memory = vk_memory.mapMemory(offsets[frame + 2], sizeof(TransformSSBO));
-  memcpy(memory, &buffer, sizeof(buffer));
-  vk_memory.unmapMemory();
+  FrameConstants constants = basis;
+  constants.jitter[0] = halton(samples + 1, 2);
+  constants.jitter[1] = halton(samples + 1, 3);
+  constants.index = samples;
+  constants.seed = (samples + 1) * 2654435761u;
+
+  if (!converged())
+    ++samples;
+
+  return constants;
 }
 
-std::vector<char> Camera::read(std::string path) const
+// the frame's fence has been waited on, so its uniform is no longer read by the GPU
+void Camera::updateFrame(unsigned int frame)
 {
-  std::vector<char> buffer;
+  *static_cast<FrameConstants *>(frameBuffers[frame].data()) = nextFrame();
+}
 
-  std::ifstream shader(path, std::ios::ate | std::ios::binary);
-  if (shader.fail()) return buffer;
+const Tolerances& Camera::geodesicTolerances() const
+{
+  return tolerances;
+}
 
-  unsigned long size = shader.tellg();
-  buffer.resize(size);
+// takes effect from the next updateSpacetime(), and restarts accumulation since every ray changes
+void Camera::setTolerances(const Tolerances& t)
+{
+  tolerances = t;
+  resetSamples();
+}
 
-  shader.seekg(0);
-  shader.read(buffer.data(), size);
+// Lookup falls back to Integrate when load() was handed an empty table
+void Camera::setBending(Bending b)
+{
+  bending = b;
+  resetSamples();
+}
 
-  return buffer;
+void Camera::updateSpacetime(unsigned int frame, const TransformStore& transforms)
+{
+  if (lensRevision != transforms.revision())
+  {
+    lenses = gatherLenses(transforms);
+    lensRevision = transforms.revision();
+  }
+
+  Bending mode = lookup ? bending : Bending::Integrate;
+  *static_cast<SpacetimeConstants *>(spacetimeBuffers[frame].data()) = spacetimeConstants(lenses, tolerances, mode);
+}
+
+// reads and clears what the frame's last submission counted, so it must follow its fence
+std::optional<float> Camera::stepsPerRay(unsigned int frame)
+{
+  auto counters = static_cast<GeodesicCounters *>(counterBuffers[frame].data());
+
+  std::optional<float> average;
+  if (counters->rays > 0)
+    average = static_cast<float>(counters->steps) / counters->rays;
+
+  *counters = GeodesicCounters{};
+  return average;
+}
+
+// takes effect at the next load(), where it is baked into the compute pipeline
+void Camera::setWorkgroupSize(unsigned int x, unsigned int y)
+{
+  workgroup = { std::max(x, 1u), std::max(y, 1u) };
 }
 
-std::array<vk::raii::ShaderModule, 2> Camera::shaderModules(const vecs::Device& vecs_device) const
+// pipeline compilation dominates startup, so both pipelines are built on their own threads while
+// the buffers, images and descriptors are created; waitPipelines() joins them before the first draw
+void Camera::load(const Device& device, const PipelineCache& cache, const LensingTable& lensing)
+{
+  loadLayouts(device);
+
+  auto timed = [](auto build) {
+    auto start = std::chrono::steady_clock::now();
+    build();
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  graphicsTask = std::async(std::launch::async, [this, &device, &cache, timed]() {
+    return timed([&]() { loadPipeline(device, cache); });
+  });
+
+  computeTask = std::async(std::launch::async, [this, &device, &cache, timed]() {
+    return timed([&]() { loadComputePipeline(device, cache); });
+  });
+
+  allocateUniforms(device, lensing);
+  allocateAccumulation(device);
+  loadDescriptors(device);
+}
+
+// records the slower of the two builds, which is what startup waits on
+void Camera::waitPipelines(PipelineCache& cache)
+{
+  if (!graphicsTask.valid() || !computeTask.valid())
+    return;
+
+  float graphics = graphicsTask.get();
+  float compute = computeTask.get();
+
+  cache.record(std::max(graphics, compute));
+  ++changes;
+}
+
+ObjectData * Camera::objects(const Device& device, unsigned int frame, unsigned long count)
+{
+  vk::DeviceSize size = sizeof(TransformSSBO) + count * sizeof(ObjectData);
+
+  if (ssbos[frame].reserve(device, size))
+    writeDescriptor(device, frame);
+
+  char * memory = static_cast<char *>(ssbos[frame].data());
+  reinterpret_cast<TransformSSBO *>(memory)->size = static_cast<unsigned int>(count);
+  ssbos[frame].touch(0, sizeof(TransformSSBO));
+
+  return reinterpret_cast<ObjectData *>(memory + sizeof(TransformSSBO));
+}
+
+// sized and indexed by slot like objects(), so the two are always written together
+Boost * Camera::boosts(const Device& device, unsigned int frame, unsigned long count)
+{
+  if (boostBuffers[frame].reserve(device, std::max(count, 1ul) * sizeof(Boost)))
+    writeDescriptor(device, frame);
+
+  return static_cast<Boost *>(boostBuffers[frame].data());
+}
+
+void Camera::commitObjects(unsigned int frame, unsigned long first, unsigned long last)
+{
+  ssbos[frame].touch(sizeof(TransformSSBO) + first * sizeof(ObjectData), (last - first) * sizeof(ObjectData));
+  boostBuffers[frame].touch(first * sizeof(Boost), (last - first) * sizeof(Boost));
+}
+
+void Camera::updateBVH(const Device& device, unsigned int frame, const BVH& bvh)
+{
+  vk::DeviceSize nodeSize = bvh.nodes().size() * sizeof(BVHNode);
+  vk::DeviceSize indexSize = bvh.indices().size() * sizeof(unsigned int);
+
+  bool reallocated = bvhNodes[frame].reserve(device, nodeSize);
+  reallocated = bvhIndices[frame].reserve(device, indexSize) || reallocated;
+
+  if (reallocated)
+    writeDescriptor(device, frame);
+
+  memcpy(bvhNodes[frame].data(), bvh.nodes().data(), nodeSize);
+  memcpy(bvhIndices[frame].data(), bvh.indices().data(), indexSize);
+
+  bvhNodes[frame].touch(0, nodeSize);
+  bvhIndices[frame].touch(0, indexSize);
+}
+
+void Camera::recordUploads(const vk::raii::CommandBuffer& vk_commandBuffer, unsigned int frame)
+{
+  ssbos[frame].record(vk_commandBuffer);
+  boostBuffers[frame].record(vk_commandBuffer);
+  bvhNodes[frame].record(vk_commandBuffer);
+  bvhIndices[frame].record(vk_commandBuffer);
+}
+
+void Camera::updateSSBO(const Device& device, unsigned int frame, const TransformStore& transforms)
+{
+  updateSSBO(device, frame, transforms, 0, transforms.size());
+}
+
+void Camera::updateSSBO(
+  const Device& device,
+  unsigned int frame,
+  const TransformStore& transforms,
+  unsigned long first,
+  unsigned long last
+)
+{
+  ObjectData * out = objects(device, frame, transforms.size());
+  Boost * boosted = boosts(device, frame, transforms.size());
+
+  transforms.pack(out, first, last);
+  computeBoosts(transforms, boosted, first, last);
+  commitObjects(frame, first, last);
+}
+
+void Camera::updateSSBO(
+  const Device& device,
+  unsigned int frame,
+  const TransformStore& transforms,
+  unsigned long first,
+  unsigned long last,
+  JobSystem& jobs
+)
+{
+  ObjectData * out = objects(device, frame, transforms.size());
+  Boost * boosted = boosts(device, frame, transforms.size());
+
+  // one pass over the slots writes both records, while each chunk is still in cache
+  jobs.parallel_for(first, last, STR_JOB_GRAIN, [&transforms, out, boosted](unsigned long begin, unsigned long end) {
+    transforms.pack(out, begin, end);
+    computeBoosts(transforms, boosted, begin, end);
+  });
+
+  commitObjects(frame, first, last);
+}
+
+std::array<vk::raii::ShaderModule, 2> Camera::shaderModules(const Device& device) const
 {
   std::array<vk::raii::ShaderModule, 2> modules = { nullptr, nullptr };
-  std::array<std::string, 2> paths = { "shaders/camera.vert.spv", "shaders/camera.frag.spv" };
+  std::array<std::span<const unsigned int>, 2> code = { spirv::camera_vert, spirv::camera_frag };
 
   for (unsigned int i = 0; i < 2; ++i)
   {
-    auto code = read(paths[i]);
-
     vk::ShaderModuleCreateInfo ci_module{
-      .codeSize = code.size(),
-      .pCode    = reinterpret_cast<const unsigned int *>(code.data())
+      .codeSize = code[i].size_bytes(),
+      .pCode    = code[i].data()
     };
 
-    modules[i] = vecs_device.logical().createShaderModule(ci_module);
+    modules[i] = device.logical().createShaderModule(ci_module);
   }
 
   return modules;
@@ -187,34 +424,58 @@ std::array<vk::PipelineShaderStageCreateInfo, 2> Camera::createInfos(const std::
   return infos;
 }
 
-unsigned int Camera::findIndex(
-  const vk::raii::PhysicalDevice& vk_physicalDevice,
-  unsigned int filter,
-  vk::MemoryPropertyFlags flags
-) const
+void Camera::setView(la::vec<3> pos, la::vec<3> norm)
+{
+  view = la::mat<4>::view_matrix(pos, pos + norm, { 0.0, -1.0, 0.0 });
+  stale = true;
+  resetSamples();
+}
+
+void Camera::loadLayouts(const Device& device)
 {
-  auto properties = vk_physicalDevice.getMemoryProperties();
+  std::array<vk::DescriptorType, 9> types = {
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eStorageImage,
+    vk::DescriptorType::eUniformBuffer,
+    vk::DescriptorType::eUniformBuffer,
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eStorageBuffer,
+    vk::DescriptorType::eStorageBuffer
+  };
 
-  for (unsigned long i = 0; i < properties.memoryTypeCount; ++i)
+  std::array<vk::DescriptorSetLayoutBinding, 9> bindings;
+  for (unsigned int i = 0; i < bindings.size(); ++i)
   {
-    if ((filter & (1 << i)) &&
-        (properties.memoryTypes[i].propertyFlags & flags) == flags)
-    {
-      return i;
-    }
+    bindings[i] = vk::DescriptorSetLayoutBinding{
+      .binding          = i,
+      .descriptorType   = types[i],
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eFragment | vk::ShaderStageFlagBits::eCompute
+    };
   }
 
-  throw std::runtime_error("error @ str::Camera::findIndex() : could not find suitable memory index");
-}
+  vk::DescriptorSetLayoutCreateInfo ci_descriptorLayout{
+    .bindingCount = static_cast<unsigned int>(bindings.size()),
+    .pBindings    = bindings.data()
+  };
 
-void Camera::setView(la::vec<3> pos, la::vec<3> norm)
-{
-  view = la::mat<4>::view_matrix(pos, pos + norm, { 0.0, -1.0, 0.0 });
+  vk_descriptorLayout = device.logical().createDescriptorSetLayout(ci_descriptorLayout);
+
+  // everything per frame, the camera included, is in the descriptor set
+  vk::PipelineLayoutCreateInfo ci_pipelineLayout{
+    .setLayoutCount = 1,
+    .pSetLayouts    = &*vk_descriptorLayout
+  };
+
+  vk_pipelineLayout = device.logical().createPipelineLayout(ci_pipelineLayout);
+  vk_computeLayout = device.logical().createPipelineLayout(ci_pipelineLayout);
 }
 
-void Camera::loadPipeline(const vecs::Device& vecs_device, const vecs::GUI& vecs_gui)
+void Camera::loadPipeline(const Device& device, const PipelineCache& cache)
 {
-  auto modules = shaderModules(vecs_device);
+  auto modules = shaderModules(device);
   auto stages = createInfos(modules);
 
   std::vector<vk::DynamicState> dynamicStates{
@@ -295,35 +556,6 @@ void Camera::loadPipeline(const vecs::Device& vecs_device, const vecs::GUI& vecs
     .pAttachments     = &blendState
   };
 
-  vk::DescriptorSetLayoutBinding transformsBinding{
-    .binding          = 0,
-    .descriptorType   = vk::DescriptorType::eStorageBuffer,
-    .descriptorCount  = 1,
-    .stageFlags       = vk::ShaderStageFlagBits::eFragment
-  };
-
-  vk::DescriptorSetLayoutCreateInfo ci_descriptorLayout{
-    .bindingCount = 1,
-    .pBindings    = &transformsBinding
-  };
-
-  vk_descriptorLayout = vecs_device.logical().createDescriptorSetLayout(ci_descriptorLayout);
-
-  vk::PushConstantRange camera{
-    .stageFlags = vk::ShaderStageFlagBits::eVertex,
-    .offset     = 0,
-    .size       = sizeof(la::mat<4>) + sizeof(la::vec<3>)
-  };
-
-  vk::PipelineLayoutCreateInfo ci_pipelineLayout{
-    .setLayoutCount         = 1,
-    .pSetLayouts            = &*vk_descriptorLayout,
-    .pushConstantRangeCount = 1,
-    .pPushConstantRanges    = &camera
-  };
-
-  vk_pipelineLayout = vecs_device.logical().createPipelineLayout(ci_pipelineLayout);
-
   auto format = VECS_SETTINGS.format();
   auto dformat = VECS_SETTINGS.depth_format();
   vk::PipelineRenderingCreateInfoKHR ci_rendering{
@@ -347,37 +579,85 @@ void Camera::loadPipeline(const vecs::Device& vecs_device, const vecs::GUI& vecs
     .layout               = *vk_pipelineLayout,
   };
 
-  vk_pipeline = vecs_device.logical().createGraphicsPipeline(nullptr, ci_pipeline);
+  vk_pipeline = device.logical().createGraphicsPipeline(cache.cache(), ci_pipeline);
 }
 
-void Camera::allocateUniforms(const vecs::Device& vecs_device)
+void Camera::loadComputePipeline(const Device& device, const PipelineCache& cache)
+{
+  vk::ShaderModuleCreateInfo ci_module{
+    .codeSize = sizeof(spirv::camera_comp),
+    .pCode    = spirv::camera_comp
+  };
+
+  vk::raii::ShaderModule module = device.logical().createShaderModule(ci_module);
+
+  std::array<vk::SpecializationMapEntry, 2> entries = {
+    vk::SpecializationMapEntry{ .constantID = 0, .offset = 0, .size = sizeof(unsigned int) },
+    vk::SpecializationMapEntry{ .constantID = 1, .offset = sizeof(unsigned int), .size = sizeof(unsigned int) }
+  };
+
+  vk::SpecializationInfo i_specialization{
+    .mapEntryCount  = static_cast<unsigned int>(entries.size()),
+    .pMapEntries    = entries.data(),
+    .dataSize       = sizeof(workgroup),
+    .pData          = workgroup.data()
+  };
+
+  vk::ComputePipelineCreateInfo ci_pipeline{
+    .stage  = vk::PipelineShaderStageCreateInfo{
+      .stage                = vk::ShaderStageFlagBits::eCompute,
+      .module               = *module,
+      .pName                = "main",
+      .pSpecializationInfo  = &i_specialization
+    },
+    .layout = *vk_computeLayout
+  };
+
+  vk_computePipeline = device.logical().createComputePipeline(cache.cache(), ci_pipeline);
+}
+
+void Camera::allocateUniforms(const Device& device, const LensingTable& lensing)
 {
   vk::DeviceSize vertexSize = sizeof(Vertex) * 4;
   vk::DeviceSize indexSize = sizeof(unsigned int) * 6;
-  vk::DeviceSize ssboSize = sizeof(TransformSSBO);
+  vk::DeviceSize ssboSize = sizeof(TransformSSBO) + STR_INITIAL_TRANSFORMS * sizeof(ObjectData);
 
   vk::BufferCreateInfo ci_vertex{
     .size         = vertexSize,
-    .usage        = vk::BufferUsageFlagBits::eVertexBuffer,
+    .usage        = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
     .sharingMode  = vk::SharingMode::eExclusive
   };
-  vk_buffers.emplace_back(vecs_device.logical().createBuffer(ci_vertex));
+  vk_buffers.emplace_back(device.logical().createBuffer(ci_vertex));
 
   vk::BufferCreateInfo ci_index{
     .size         = indexSize,
-    .usage        = vk::BufferUsageFlagBits::eIndexBuffer,
+    .usage        = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst,
     .sharingMode  = vk::SharingMode::eExclusive
   };
-  vk_buffers.emplace_back(vecs_device.logical().createBuffer(ci_index));
+  vk_buffers.emplace_back(device.logical().createBuffer(ci_index));
 
-  vk::BufferCreateInfo ci_ssbo{
-    .size         = ssboSize,
-    .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
-    .sharingMode  = vk::SharingMode::eExclusive
-  };
+  vk::DeviceSize bvhSize = 2 * STR_INITIAL_TRANSFORMS * sizeof(BVHNode);
+  vk::DeviceSize bvhIndexSize = STR_INITIAL_TRANSFORMS * sizeof(unsigned int);
+
+  ssbos.resize(VECS_SETTINGS.max_flight_frames());
+  boostBuffers.resize(VECS_SETTINGS.max_flight_frames());
+  bvhNodes.resize(VECS_SETTINGS.max_flight_frames());
+  bvhIndices.resize(VECS_SETTINGS.max_flight_frames());
+  frameBuffers.resize(VECS_SETTINGS.max_flight_frames());
+  spacetimeBuffers.resize(VECS_SETTINGS.max_flight_frames());
+  counterBuffers.resize(VECS_SETTINGS.max_flight_frames());
 
   for (unsigned long i = 0; i < VECS_SETTINGS.max_flight_frames(); ++i)
-    vk_buffers.emplace_back(vecs_device.logical().createBuffer(ci_ssbo));
+  {
+    ssbos[i].reserve(device, ssboSize);
+    boostBuffers[i].reserve(device, STR_INITIAL_TRANSFORMS * sizeof(Boost));
+    bvhNodes[i].reserve(device, bvhSize);
+    bvhIndices[i].reserve(device, bvhIndexSize);
+
+    frameBuffers[i].allocate(device, sizeof(FrameConstants), vk::BufferUsageFlagBits::eUniformBuffer);
+    spacetimeBuffers[i].allocate(device, sizeof(SpacetimeConstants), vk::BufferUsageFlagBits::eUniformBuffer);
+    counterBuffers[i].allocate(device, sizeof(GeodesicCounters), vk::BufferUsageFlagBits::eStorageBuffer);
+  }
 
   vk::DeviceSize size = 0;
   for (const auto& vk_buffer : vk_buffers)
@@ -393,13 +673,13 @@ void Camera::allocateUniforms(const vecs::Device& vecs_device)
 
   vk::MemoryAllocateInfo ai_memory{
     .allocationSize = size,
-    .memoryTypeIndex = findIndex(
-      vecs_device.physical(),
-      vk_buffers[0].getMemoryRequirements().memoryTypeBits,
-      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    .memoryTypeIndex = findMemoryIndex(
+      device.physical(),
+      vk_buffers[0].getMemoryRequirements().memoryTypeBits & vk_buffers[1].getMemoryRequirements().memoryTypeBits,
+      vk::MemoryPropertyFlagBits::eDeviceLocal
     )
   };
-  vk_memory = vecs_device.logical().allocateMemory(ai_memory);
+  vk_memory = device.logical().allocateMemory(ai_memory);
 
   unsigned long index = 0;
   for (const auto& vk_buffer : vk_buffers)
@@ -414,32 +694,146 @@ void Camera::allocateUniforms(const vecs::Device& vecs_device)
 
   std::array<unsigned int, 6> indices = { 0, 1, 2, 2, 3, 0 };
 
-  void * memory = vk_memory.mapMemory(0, vertexSize);
-  memcpy(memory, vertices.data(), sizeof(vertices));
-  vk_memory.unmapMemory();
+  // the lensing table goes up with the quad. a scene without masses never loads one, so a single
+  // zero entry stands in for it and the shaders, left integrating, never read it
+  std::vector<Deflection> dummy(1);
+  const std::vector<Deflection>& table = lensing.empty() ? dummy : lensing.data();
+  lookup = !lensing.empty();
+
+  LensingSSBO header = lensing.header();
+  if (!lookup)
+    header = LensingSSBO{ .impact = 1, .distance = 1, .reach = STR_LENSING_REACH, .padding = 0.0f };
+
+  vk::DeviceSize tableSize = table.size() * sizeof(Deflection);
+  vk::DeviceSize lensingSize = sizeof(LensingSSBO) + tableSize;
+
+  createBuffer(
+    device,
+    lensingSize,
+    vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+    vk::MemoryPropertyFlagBits::eDeviceLocal,
+    vk_lensingBuffer,
+    vk_lensingMemory
+  );
+
+  vk::raii::Buffer vk_staging = nullptr;
+  vk::raii::DeviceMemory vk_stagingMemory = nullptr;
+  createBuffer(
+    device,
+    vertexSize + indexSize + lensingSize,
+    vk::BufferUsageFlagBits::eTransferSrc,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+    vk_staging,
+    vk_stagingMemory
+  );
+
+  char * memory = static_cast<char *>(vk_stagingMemory.mapMemory(0, vertexSize + indexSize + lensingSize));
+  memcpy(memory, vertices.data(), vertexSize);
+  memcpy(memory + vertexSize, indices.data(), indexSize);
+  memcpy(memory + vertexSize + indexSize, &header, sizeof(LensingSSBO));
+  memcpy(memory + vertexSize + indexSize + sizeof(LensingSSBO), table.data(), tableSize);
+  vk_stagingMemory.unmapMemory();
+
+  submitImmediate(device, [&](const vk::raii::CommandBuffer& vk_commandBuffer){
+    vk_commandBuffer.copyBuffer(*vk_staging, *vk_buffers[0], vk::BufferCopy{ .srcOffset = 0, .dstOffset = 0, .size = vertexSize });
+    vk_commandBuffer.copyBuffer(*vk_staging, *vk_buffers[1], vk::BufferCopy{ .srcOffset = vertexSize, .dstOffset = 0, .size = indexSize });
+    vk_commandBuffer.copyBuffer(*vk_staging, *vk_lensingBuffer, vk::BufferCopy{ .srcOffset = vertexSize + indexSize, .dstOffset = 0, .size = lensingSize });
+  });
+}
 
-  memory = vk_memory.mapMemory(offsets[1], indexSize);
-  memcpy(memory, indices.data(), sizeof(indices));
-  vk_memory.unmapMemory();
+void Camera::allocateAccumulation(const Device& device)
+{
+  accumulation_extent = VECS_SETTINGS.extent();
+  stale = true;
+
+  vk::ImageCreateInfo ci_image{
+    .imageType      = vk::ImageType::e2D,
+    .format         = STR_ACCUMULATION_FORMAT,
+    .extent         = { accumulation_extent.width, accumulation_extent.height, 1 },
+    .mipLevels      = 1,
+    .arrayLayers    = 1,
+    .samples        = vk::SampleCountFlagBits::e1,
+    .tiling         = vk::ImageTiling::eOptimal,
+    .usage          = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eTransferSrc,
+    .sharingMode    = vk::SharingMode::eExclusive,
+    .initialLayout  = vk::ImageLayout::eUndefined
+  };
+
+  vk_accumulation = device.logical().createImage(ci_image);
+  auto requirements = vk_accumulation.getMemoryRequirements();
+
+  vk::MemoryAllocateInfo ai_memory{
+    .allocationSize   = requirements.size,
+    .memoryTypeIndex  = findMemoryIndex(device.physical(), requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal)
+  };
+
+  vk_accumulationMemory = device.logical().allocateMemory(ai_memory);
+  vk_accumulation.bindMemory(*vk_accumulationMemory, 0);
+
+  vk::ImageSubresourceRange range{
+    .aspectMask     = vk::ImageAspectFlagBits::eColor,
+    .baseMipLevel   = 0,
+    .levelCount     = 1,
+    .baseArrayLayer = 0,
+    .layerCount     = 1
+  };
+
+  vk::ImageViewCreateInfo ci_view{
+    .image            = *vk_accumulation,
+    .viewType         = vk::ImageViewType::e2D,
+    .format           = STR_ACCUMULATION_FORMAT,
+    .subresourceRange = range
+  };
+
+  vk_accumulationView = device.logical().createImageView(ci_view);
+
+  // the shader never reads the image before the first sample overwrites it, so only the layout matters
+  submitImmediate(device, [&](const vk::raii::CommandBuffer& vk_commandBuffer){
+    vk::ImageMemoryBarrier memoryBarrier{
+      .dstAccessMask    = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+      .oldLayout        = vk::ImageLayout::eUndefined,
+      .newLayout        = vk::ImageLayout::eGeneral,
+      .image            = *vk_accumulation,
+      .subresourceRange = range
+    };
+
+    vk_commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTopOfPipe,
+      vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      memoryBarrier
+    );
+  });
 }
 
-void Camera::loadDescriptors(const vecs::Device& vecs_device)
+void Camera::loadDescriptors(const Device& device)
 {
-  vk::DescriptorPoolSize poolSize{
-    .type             = vk::DescriptorType::eStorageBuffer,
-    .descriptorCount  = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames())
+  std::array<vk::DescriptorPoolSize, 3> poolSizes = {
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = static_cast<unsigned int>(6 * VECS_SETTINGS.max_flight_frames())
+    },
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eStorageImage,
+      .descriptorCount  = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames())
+    },
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eUniformBuffer,
+      .descriptorCount  = static_cast<unsigned int>(2 * VECS_SETTINGS.max_flight_frames())
+    }
   };
 
   vk::DescriptorPoolCreateInfo ci_descriptorPool{
     .flags          = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
     .maxSets        = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames()),
-    .poolSizeCount  = 1,
-    .pPoolSizes     = &poolSize
+    .poolSizeCount  = static_cast<unsigned int>(poolSizes.size()),
+    .pPoolSizes     = poolSizes.data()
   };
 
-  vk_descriptorPool = vecs_device.logical().createDescriptorPool(ci_descriptorPool);
+  vk_descriptorPool = device.logical().createDescriptorPool(ci_descriptorPool);
 
-  std::vector<vk::WriteDescriptorSet> writes;
   for (unsigned long i = 0; i < VECS_SETTINGS.max_flight_frames(); ++i)
   {
     vk::DescriptorSetAllocateInfo ai_descriptors{
@@ -447,28 +841,110 @@ void Camera::loadDescriptors(const vecs::Device& vecs_device)
       .descriptorSetCount = 1u,
       .pSetLayouts        = &*vk_descriptorLayout
     };
-    vk_descriptorSets.emplace_back(vk::raii::DescriptorSets(vecs_device.logical(), ai_descriptors));
+    vk_descriptorSets.emplace_back(vk::raii::DescriptorSets(device.logical(), ai_descriptors));
+
+    writeDescriptor(device, i);
+  }
+}
 
-    vk::DescriptorBufferInfo bufferInfo{
-      .buffer = *vk_buffers[i + 2],
+// rewriting a set invalidates every command buffer it is bound in, so this counts as a change
+void Camera::writeDescriptor(const Device& device, unsigned long frame)
+{
+  std::array<const StorageBuffer *, 3> buffers = { &ssbos[frame], &bvhNodes[frame], &bvhIndices[frame] };
+  std::array<vk::DescriptorBufferInfo, 3> bufferInfos;
+  std::array<vk::WriteDescriptorSet, 9> writes;
+
+  for (unsigned int i = 0; i < buffers.size(); ++i)
+  {
+    bufferInfos[i] = vk::DescriptorBufferInfo{
+      .buffer = *buffers[i]->buffer(),
       .offset = 0,
-      .range  = sizeof(TransformSSBO)
+      .range  = vk::WholeSize
     };
 
-    vk::WriteDescriptorSet write{
-      .dstSet           = *vk_descriptorSets[i][0],
-      .dstBinding       = 0,
+    writes[i] = vk::WriteDescriptorSet{
+      .dstSet           = *vk_descriptorSets[frame][0],
+      .dstBinding       = i,
       .dstArrayElement  = 0,
       .descriptorCount  = 1,
       .descriptorType   = vk::DescriptorType::eStorageBuffer,
-      .pBufferInfo      = &bufferInfo
+      .pBufferInfo      = &bufferInfos[i]
     };
+  }
+
+  vk::DescriptorImageInfo imageInfo{
+    .imageView    = *vk_accumulationView,
+    .imageLayout  = vk::ImageLayout::eGeneral
+  };
 
-    writes.emplace_back(write);
+  writes[3] = vk::WriteDescriptorSet{
+    .dstSet           = *vk_descriptorSets[frame][0],
+    .dstBinding       = 3,
+    .dstArrayElement  = 0,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eStorageImage,
+    .pImageInfo       = &imageInfo
+  };
+
+  // the per-frame blocks the CPU writes through their mapping: Frame, Spacetime and Counters
+  std::array<const MappedBuffer *, 3> mapped = { &frameBuffers[frame], &spacetimeBuffers[frame], &counterBuffers[frame] };
+  std::array<vk::DescriptorType, 3> mappedTypes = {
+    vk::DescriptorType::eUniformBuffer,
+    vk::DescriptorType::eUniformBuffer,
+    vk::DescriptorType::eStorageBuffer
+  };
+  std::array<vk::DescriptorBufferInfo, 3> mappedInfos;
+
+  for (unsigned int i = 0; i < mapped.size(); ++i)
+  {
+    mappedInfos[i] = vk::DescriptorBufferInfo{
+      .buffer = *mapped[i]->buffer(),
+      .offset = 0,
+      .range  = mapped[i]->size()
+    };
+
+    writes[4 + i] = vk::WriteDescriptorSet{
+      .dstSet           = *vk_descriptorSets[frame][0],
+      .dstBinding       = 4 + i,
+      .dstArrayElement  = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = mappedTypes[i],
+      .pBufferInfo      = &mappedInfos[i]
+    };
   }
 
-  vk::ArrayProxy<vk::WriteDescriptorSet> proxy(writes.size(), writes.data());
-  vecs_device.logical().updateDescriptorSets(proxy, nullptr);
+  vk::DescriptorBufferInfo lensingInfo{
+    .buffer = *vk_lensingBuffer,
+    .offset = 0,
+    .range  = vk::WholeSize
+  };
+
+  writes[7] = vk::WriteDescriptorSet{
+    .dstSet           = *vk_descriptorSets[frame][0],
+    .dstBinding       = 7,
+    .dstArrayElement  = 0,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eStorageBuffer,
+    .pBufferInfo      = &lensingInfo
+  };
+
+  vk::DescriptorBufferInfo boostInfo{
+    .buffer = *boostBuffers[frame].buffer(),
+    .offset = 0,
+    .range  = vk::WholeSize
+  };
+
+  writes[8] = vk::WriteDescriptorSet{
+    .dstSet           = *vk_descriptorSets[frame][0],
+    .dstBinding       = 8,
+    .dstArrayElement  = 0,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eStorageBuffer,
+    .pBufferInfo      = &boostInfo
+  };
+
+  device.logical().updateDescriptorSets(writes, nullptr);
+  ++changes;
 }
 
 } // namespace str
\ No newline at end of file
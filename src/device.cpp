@@ -0,0 +1,128 @@
+#include "src/include/device.hpp"
+
+#include <limits>
+
+namespace str
+{
+
+Device::Device()
+{
+  vk::ApplicationInfo i_application{
+    .pApplicationName = "str",
+    .apiVersion       = VK_API_VERSION_1_3
+  };
+
+  vk::InstanceCreateInfo ci_instance{
+    .pApplicationInfo = &i_application
+  };
+
+  vk_instance = vk::raii::Instance(vk_context, ci_instance);
+
+  pickPhysicalDevice();
+  createLogicalDevice();
+
+  p_physical = &vk_physicalDevice;
+  p_logical = &vk_device;
+  p_queue = &vk_queue;
+}
+
+Device::Device(const vecs::Device& vecs_device)
+  : family(static_cast<unsigned int>(vecs_device.familyIndex(vecs::FamilyType::All))),
+    p_physical(&vecs_device.physical()),
+    p_logical(&vecs_device.logical()),
+    p_queue(&vecs_device.queue(vecs::FamilyType::All))
+{
+}
+
+const vk::raii::PhysicalDevice& Device::physical() const
+{
+  return *p_physical;
+}
+
+const vk::raii::Device& Device::logical() const
+{
+  return *p_logical;
+}
+
+const vk::raii::Queue& Device::queue() const
+{
+  return *p_queue;
+}
+
+unsigned int Device::familyIndex() const
+{
+  return family;
+}
+
+void Device::pickPhysicalDevice()
+{
+  vk::raii::PhysicalDevices physicalDevices(vk_instance);
+
+  // hardware first, then software rasterizers such as lavapipe
+  auto rank = [](vk::PhysicalDeviceType type) {
+    switch (type)
+    {
+      case vk::PhysicalDeviceType::eDiscreteGpu:    return 0;
+      case vk::PhysicalDeviceType::eIntegratedGpu:  return 1;
+      case vk::PhysicalDeviceType::eVirtualGpu:     return 2;
+      case vk::PhysicalDeviceType::eCpu:            return 3;
+      default:                                      return 4;
+    }
+  };
+
+  int best = std::numeric_limits<int>::max();
+  for (auto& physicalDevice : physicalDevices)
+  {
+    auto properties = physicalDevice.getProperties();
+    if (properties.apiVersion < VK_API_VERSION_1_3 || rank(properties.deviceType) >= best)
+      continue;
+
+    auto families = physicalDevice.getQueueFamilyProperties();
+    for (unsigned int i = 0; i < families.size(); ++i)
+    {
+      if (families[i].queueFlags & vk::QueueFlagBits::eGraphics)
+      {
+        best = rank(properties.deviceType);
+        family = i;
+        vk_physicalDevice = std::move(physicalDevice);
+        break;
+      }
+    }
+  }
+
+  if (best == std::numeric_limits<int>::max())
+    throw std::runtime_error("error @ str::Device::pickPhysicalDevice() : no Vulkan 1.3 device with a graphics queue");
+}
+
+void Device::createLogicalDevice()
+{
+  float priority = 1.0f;
+  vk::DeviceQueueCreateInfo ci_queue{
+    .queueFamilyIndex = family,
+    .queueCount       = 1,
+    .pQueuePriorities = &priority
+  };
+
+  vk::PhysicalDeviceDynamicRenderingFeatures dynamicRendering{
+    .dynamicRendering = vk::True
+  };
+
+  vk::PhysicalDeviceFeatures2 features{
+    .pNext    = &dynamicRendering,
+    .features = { .fragmentStoresAndAtomics = vk::True }
+  };
+
+  const char * extension = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+  vk::DeviceCreateInfo ci_device{
+    .pNext                    = &features,
+    .queueCreateInfoCount     = 1,
+    .pQueueCreateInfos        = &ci_queue,
+    .enabledExtensionCount    = 1,
+    .ppEnabledExtensionNames  = &extension
+  };
+
+  vk_device = vk_physicalDevice.createDevice(ci_device);
+  vk_queue = vk_device.getQueue(family, 0);
+}
+
+} // namespace str
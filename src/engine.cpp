@@ -1,93 +1,142 @@
 #include "src/include/engine.hpp"
 #include "src/include/renderer.hpp"
+#include "src/include/scene.hpp"
 #include "src/include/transform.hpp"
 
+#include <GLFW/glfw3.h>
+
 #include <chrono>
 #include <iostream>
 
 namespace str
 {
 
+Engine::Engine(Backend b, unsigned int threads, bool pin) : backend(b), jobs(std::make_shared<JobSystem>(threads, pin))
+{
+}
+
 void Engine::load()
 {
   vk::PhysicalDeviceDynamicRenderingFeatures dynamicRendering{
     .dynamicRendering = vk::True
   };
 
-  initialize(&dynamicRendering);
+  // camera.frag accumulates samples into a storage image
+  vk::PhysicalDeviceFeatures2 features{
+    .pNext    = &dynamicRendering,
+    .features = { .fragmentStoresAndAtomics = vk::True }
+  };
+
+  initialize(&features);
 
   setupECS();
   loadComponents();
 }
 
+// the simulation thread steps the scene for upcoming frames while this thread records and submits
+// the current one, running at most max_flight_frames() ticks ahead
 void Engine::run()
 {
+  auto camera = component_manager->retrieve<p_camera>(0).value();
+
+  auto animate = [](TransformStore& world, std::optional<CameraPose>&, float elapsed, float) {
+    unsigned long slot = world.slot(1);
+    world.translate(slot, slot + 1, 0.25 * sinf(2 * la::radians(50.0f) * elapsed - 0.5), { 1.0, 0.0, 0.0 });
+  };
+
+  simulation->start(*transforms, animate, VECS_SETTINGS.max_flight_frames());
+
+  auto last_frame = std::chrono::steady_clock::now();
 
   while (!close_condition())
   {
     poll_gui();
     renderer->waitFlight();
 
-    auto start_frame = std::chrono::steady_clock::now();
+    if (const Snapshot * snapshot = simulation->acquire())
+    {
+      renderer->setTransforms(snapshot->transforms);
+
+      if (snapshot->camera)
+        camera->setView(snapshot->camera->position, snapshot->camera->direction);
+    }
+
+    bool idle = renderer->converged(*camera);
+    if (!idle)
+      renderer->update(component_manager, entity_manager->retrieve<p_camera>());
 
-    renderer->update(component_manager, entity_manager->retrieve<Transform>());
+    simulation->release();
 
-    auto transform = component_manager->retrieve<Transform>(1).value();
-    transform.translate(0.25 * sinf(2 * la::radians(50.0f) * elapsed_time - 0.5), { 1.0, 0.0, 0.0 });
-    component_manager->update_data(1, transform);
+    // a converged image has nothing left to draw, so sleep until input arrives or the timeout lets
+    // the next snapshot be checked for changes; the idle time is not counted as a frame
+    if (idle)
+    {
+      glfwWaitEventsTimeout(STR_IDLE_WAIT);
+      last_frame = std::chrono::steady_clock::now();
+      continue;
+    }
 
-    auto end_frame = std::chrono::steady_clock::now();
+    auto this_frame = std::chrono::steady_clock::now();
 
-    delta_time = std::chrono::duration<float>(end_frame - start_frame).count();
-    elapsed_time += delta_time;
+    delta_time = std::chrono::duration<float>(this_frame - last_frame).count();
+    last_frame = this_frame;
 
-    timings[index] = delta_time;
-    index = ++index % SAMPLE_SIZE;
+    profiler->record(Phase::Frame, delta_time * 1000);
   }
 
+  simulation->stop();
   vecs_device->logical().waitIdle();
+  pipelineCache->save();
 
-  float frame_time = average();
-  std::cout << "average frame time: " << frame_time * 1000 << "ms (" << 1 / frame_time << " fps)\n";
+  profiler->report(std::cout);
 }
 
-float Engine::average() const
+const Profiler& Engine::profile() const
 {
-  float sum = 0;
-  for (auto dt : timings)
-    sum += dt;
-
-  return sum / SAMPLE_SIZE;
+  return *profiler;
 }
 
 void Engine::setupECS()
 {
-  component_manager->register_components<p_camera, Transform>();
+  component_manager->register_components<p_camera>();
 
   system_manager->emplace<Renderer>();
-  system_manager->add_components<Renderer, p_camera, Transform>();
+  system_manager->add_components<Renderer, p_camera>();
   renderer = system_manager->system<Renderer>().value();
 
   entity_manager->new_entity();
   entity_manager->add_components<p_camera>(0);
   component_manager->update_data(0, std::make_shared<Camera>());
 
-  entity_manager->new_entity();
-  entity_manager->add_components<Transform>(1);
-  component_manager->update_data(1,
-    Transform({ 0.0, 1.0, 0.0 })
-      .translate(10.0, { 0.0, 0.0, 1.0 })
-      .scale({ 0.6, 0.0, 0.0 })
-  );
+  // objects are entities without components: their transforms live only in the store, which is
+  // what the simulation animates and the renderer draws
+  unsigned long e_id = 1;
+  for (const auto& object : defaultScene())
+  {
+    entity_manager->new_entity();
+    transforms->insert(e_id++, object);
+  }
 }
 
 void Engine::loadComponents()
 {
-  component_manager->retrieve<p_camera>(0).value()->load(*vecs_device, *vecs_gui);
+  device = std::make_shared<Device>(*vecs_device);
 
-  renderer->link(vecs_device, vecs_gui);
+  pipelineCache->load(*device);
+  auto camera = component_manager->retrieve<p_camera>(0).value();
+  lensing->load(*transforms, camera->geodesicTolerances(), *jobs);
+  camera->load(*device, *pipelineCache, *lensing);
+
+  renderer->link(device, vecs_device, vecs_gui);
   renderer->initialize();
   renderer->setCamera(0);
+  renderer->setTransforms(transforms);
+  renderer->setBackend(backend);
+  renderer->setProfiler(profiler);
+  renderer->setJobs(jobs);
+
+  camera->waitPipelines(*pipelineCache);
+  pipelineCache->report(std::cout);
 }
 
 } // namespace str
\ No newline at end of file
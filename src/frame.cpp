@@ -0,0 +1,31 @@
+#include "src/include/frame.hpp"
+
+#include <algorithm>
+
+namespace str
+{
+
+// the near plane spans npDims[0] x npDims[1] at depth npDims[2] in view space, across width x height
+// pixels; the corner is where pixel (0, 0) starts. view maps world to view space, so the camera's
+// position is the translation of its inverse
+FrameConstants rayBasis(const la::mat<4>& view, const la::vec<3>& npDims, unsigned int width, unsigned int height)
+{
+  la::mat<4> inverse = view.inverse();
+
+  la::vec<4> corner = inverse * la::vec<4>{ -npDims[0], -npDims[1], npDims[2], 1.0f };
+  la::vec<4> dx = inverse * la::vec<4>{ 2.0f * npDims[0] / std::max(width, 1u), 0.0f, 0.0f, 0.0f };
+  la::vec<4> dy = inverse * la::vec<4>{ 0.0f, 2.0f * npDims[1] / std::max(height, 1u), 0.0f, 0.0f };
+
+  FrameConstants constants;
+  constants.inverseView = inverse;
+  constants.origin = { inverse[3][0], inverse[3][1], inverse[3][2] };
+  constants.corner = { corner[0], corner[1], corner[2] };
+  constants.dx = { dx[0], dx[1], dx[2] };
+  constants.dy = { dy[0], dy[1], dy[2] };
+  constants.extent[0] = width;
+  constants.extent[1] = height;
+
+  return constants;
+}
+
+} // namespace str
@@ -0,0 +1,52 @@
+#include "src/include/framebuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace str
+{
+
+void Framebuffer::resize(unsigned int w, unsigned int h)
+{
+  width = w;
+  height = h;
+  pixels.assign(static_cast<unsigned long>(w) * h, la::vec<3>::zero());
+}
+
+void Framebuffer::write(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+
+  if (!file.is_open())
+    throw std::runtime_error("error @ str::Framebuffer::write() : could not open " + path);
+
+  file << "P6\n" << width << " " << height << "\n255\n";
+
+  for (const auto& pixel : pixels)
+  {
+    for (unsigned long i = 0; i < 3; ++i)
+      file.put(static_cast<char>(std::clamp(pixel[i], 0.0f, 1.0f) * 255.0f + 0.5f));
+  }
+}
+
+float Framebuffer::rmse(const Framebuffer& other) const
+{
+  if (width != other.width || height != other.height)
+    throw std::runtime_error("error @ str::Framebuffer::rmse() : framebuffer dimensions differ");
+
+  if (pixels.empty())
+    return 0.0f;
+
+  double sum = 0.0;
+  for (unsigned long i = 0; i < pixels.size(); ++i)
+  {
+    la::vec<3> d = pixels[i] - other.pixels[i];
+    sum += d * d;
+  }
+
+  return static_cast<float>(std::sqrt(sum / (3.0 * pixels.size())));
+}
+
+} // namespace str
@@ -0,0 +1,147 @@
+#include "src/include/geodesic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace str
+{
+
+// the first STR_MAX_LENSES objects with a mass, which is all the uniform has room for
+std::vector<Lens> gatherLenses(const TransformStore& transforms)
+{
+  std::vector<Lens> lenses;
+
+  const auto& positions = transforms.positions();
+  const auto& masses = transforms.masses();
+
+  for (unsigned long i = 0; i < transforms.size() && lenses.size() < STR_MAX_LENSES; ++i)
+  {
+    if (masses[i] <= 0.0f)
+      continue;
+
+    lenses.push_back(Lens{
+      .position = { positions[i][0], positions[i][1], positions[i][2] },
+      .mass     = masses[i]
+    });
+  }
+
+  return lenses;
+}
+
+SpacetimeConstants spacetimeConstants(const std::vector<Lens>& lenses, const Tolerances& tolerances, Bending bending)
+{
+  SpacetimeConstants constants{
+    .lenses   = {},
+    .count    = static_cast<unsigned int>(std::min(lenses.size(), static_cast<unsigned long>(STR_MAX_LENSES))),
+    .relative = tolerances.relative,
+    .absolute = tolerances.absolute,
+    .steps    = tolerances.steps,
+    .distance = tolerances.distance,
+    .escape   = STR_GEODESIC_ESCAPE,
+    .bending  = bending
+  };
+
+  std::copy_n(lenses.begin(), constants.count, constants.lenses);
+  return constants;
+}
+
+// null geodesics of a Schwarzschild mass follow x'' = -3/2 rs h^2 x / r^5 with h = |x x v|, which
+// keeps the orbit shape exact; several masses are superposed, which holds while they are far apart
+la::vec<3> bend(const la::vec<3>& x, const la::vec<3>& v, const std::vector<Lens>& lenses)
+{
+  la::vec<3> a = la::vec<3>::zero();
+
+  for (const Lens& lens : lenses)
+  {
+    la::vec<3> d = x - la::vec<3>{ lens.position[0], lens.position[1], lens.position[2] };
+    la::vec<3> h = d % v;
+
+    float r2 = d * d;
+    float rs = 2.0f * lens.mass;
+
+    a = a - (1.5f * rs * (h * h) / (r2 * r2 * std::sqrt(r2))) * d;
+  }
+
+  return a;
+}
+
+// one Dormand-Prince 5(4) step of size h from p, whose derivative k1 carries over from the previous
+// step; writes the fifth order result and its derivative and returns the error relative to the
+// tolerances, so the step is acceptable when the result is at most 1
+float dormandPrince(const Photon& p, const la::vec<3>& k1, float h, const std::vector<Lens>& lenses,
+                    Photon& next, la::vec<3>& k7, const Tolerances& tolerances)
+{
+  const la::vec<3>& v1 = p.v;
+
+  la::vec<3> x2 = p.x + h * (1.0f / 5 * v1);
+  la::vec<3> v2 = p.v + h * (1.0f / 5 * k1);
+  la::vec<3> k2 = bend(x2, v2, lenses);
+
+  la::vec<3> x3 = p.x + h * (3.0f / 40 * v1 + 9.0f / 40 * v2);
+  la::vec<3> v3 = p.v + h * (3.0f / 40 * k1 + 9.0f / 40 * k2);
+  la::vec<3> k3 = bend(x3, v3, lenses);
+
+  la::vec<3> x4 = p.x + h * (44.0f / 45 * v1 - 56.0f / 15 * v2 + 32.0f / 9 * v3);
+  la::vec<3> v4 = p.v + h * (44.0f / 45 * k1 - 56.0f / 15 * k2 + 32.0f / 9 * k3);
+  la::vec<3> k4 = bend(x4, v4, lenses);
+
+  la::vec<3> x5 = p.x + h * (19372.0f / 6561 * v1 - 25360.0f / 2187 * v2 + 64448.0f / 6561 * v3 - 212.0f / 729 * v4);
+  la::vec<3> v5 = p.v + h * (19372.0f / 6561 * k1 - 25360.0f / 2187 * k2 + 64448.0f / 6561 * k3 - 212.0f / 729 * k4);
+  la::vec<3> k5 = bend(x5, v5, lenses);
+
+  la::vec<3> x6 = p.x + h * (9017.0f / 3168 * v1 - 355.0f / 33 * v2 + 46732.0f / 5247 * v3 + 49.0f / 176 * v4 - 5103.0f / 18656 * v5);
+  la::vec<3> v6 = p.v + h * (9017.0f / 3168 * k1 - 355.0f / 33 * k2 + 46732.0f / 5247 * k3 + 49.0f / 176 * k4 - 5103.0f / 18656 * k5);
+  la::vec<3> k6 = bend(x6, v6, lenses);
+
+  next.x = p.x + h * (35.0f / 384 * v1 + 500.0f / 1113 * v3 + 125.0f / 192 * v4 - 2187.0f / 6784 * v5 + 11.0f / 84 * v6);
+  next.v = p.v + h * (35.0f / 384 * k1 + 500.0f / 1113 * k3 + 125.0f / 192 * k4 - 2187.0f / 6784 * k5 + 11.0f / 84 * k6);
+  k7 = bend(next.x, next.v, lenses);
+
+  // difference between the fifth and embedded fourth order solutions
+  la::vec<3> ex = h * (71.0f / 57600 * v1 - 71.0f / 16695 * v3 + 71.0f / 1920 * v4 - 17253.0f / 339200 * v5 + 22.0f / 525 * v6 - 1.0f / 40 * next.v);
+  la::vec<3> ev = h * (71.0f / 57600 * k1 - 71.0f / 16695 * k3 + 71.0f / 1920 * k4 - 17253.0f / 339200 * k5 + 22.0f / 525 * k6 - 1.0f / 40 * k7);
+
+  float speed = p.v.norm();
+  float position = ex.norm() / (tolerances.absolute + tolerances.relative * h * speed);
+  float direction = ev.norm() / (tolerances.absolute + tolerances.relative * speed);
+
+  return std::max(position, direction);
+}
+
+float nearestLens(const la::vec<3>& x, const std::vector<Lens>& lenses)
+{
+  float nearest = std::numeric_limits<float>::max();
+
+  for (const Lens& lens : lenses)
+    nearest = std::min(nearest, (x - la::vec<3>{ lens.position[0], lens.position[1], lens.position[2] }).norm());
+
+  return nearest;
+}
+
+bool captured(const la::vec<3>& x, const std::vector<Lens>& lenses)
+{
+  for (const Lens& lens : lenses)
+  {
+    if ((x - la::vec<3>{ lens.position[0], lens.position[1], lens.position[2] }).norm() < 2.0f * lens.mass)
+      return true;
+  }
+
+  return false;
+}
+
+// far from every mass and moving away from all of them, the rest of the path is a straight line
+bool escaped(const Photon& p, const std::vector<Lens>& lenses)
+{
+  for (const Lens& lens : lenses)
+  {
+    la::vec<3> d = p.x - la::vec<3>{ lens.position[0], lens.position[1], lens.position[2] };
+
+    if (d * p.v < 0.0f || d.norm() < STR_GEODESIC_ESCAPE * 2.0f * lens.mass)
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace str
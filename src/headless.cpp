@@ -0,0 +1,102 @@
+#include "src/include/headless.hpp"
+#include "src/include/scene.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace str
+{
+
+Headless::Headless(Backend b, unsigned int threads, bool pin) : backend(b), jobs(std::make_shared<JobSystem>(threads, pin))
+{
+}
+
+void Headless::load()
+{
+  device = std::make_shared<Device>();
+
+  unsigned long e_id = 1;
+  for (const auto& object : defaultScene())
+    transforms->insert(e_id++, object);
+
+  pipelineCache->load(*device);
+  lensing->load(*transforms, camera->geodesicTolerances(), *jobs);
+  camera->load(*device, *pipelineCache, *lensing);
+  offscreen->load(*device, VECS_SETTINGS.extent());
+
+  renderer->link(device, offscreen);
+  renderer->initialize();
+  renderer->setTransforms(transforms);
+  renderer->setBackend(backend);
+  renderer->setProfiler(profiler);
+  renderer->setJobs(jobs);
+
+  camera->waitPipelines(*pipelineCache);
+  pipelineCache->report(std::cout);
+}
+
+// renders the given number of frames, or when frames is 0 until the camera's sample budget is spent
+// or two consecutive readbacks agree, and returns how many frames were rendered
+unsigned long Headless::run(unsigned long frames)
+{
+  bool converge = frames == 0;
+  unsigned long limit = converge ? STR_HEADLESS_MAX_FRAMES : frames;
+  unsigned long flight = VECS_SETTINGS.max_flight_frames();
+
+  Framebuffer previous;
+  unsigned long rendered = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  while (rendered < limit && !(converge && renderer->converged(*camera)))
+  {
+    auto scope = profiler->scope(Phase::Frame);
+
+    renderer->waitFlight();
+
+    // the slot about to be reused holds the oldest finished frame
+    if (converge && rendered >= flight)
+    {
+      offscreen->read(renderer->currentFrame(), framebuffer);
+
+      if (!previous.pixels.empty() && framebuffer.rmse(previous) < STR_CONVERGED_RMSE)
+        break;
+
+      std::swap(previous, framebuffer);
+    }
+
+    renderer->draw(*camera);
+    ++rendered;
+  }
+
+  device->logical().waitIdle();
+  pipelineCache->save();
+
+  float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "headless: " << rendered << " frames in " << seconds * 1000 << "ms ("
+            << seconds * 1000 / rendered << "ms/frame, " << rendered / seconds << " fps)\n";
+  profiler->report(std::cout);
+
+  if (rendered > 0)
+    offscreen->read(previousFrame(), framebuffer);
+
+  return rendered;
+}
+
+const Framebuffer& Headless::result() const
+{
+  return framebuffer;
+}
+
+const Profiler& Headless::profile() const
+{
+  return *profiler;
+}
+
+unsigned int Headless::previousFrame() const
+{
+  unsigned int flight = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames());
+  return (renderer->currentFrame() + flight - 1) % flight;
+}
+
+} // namespace str
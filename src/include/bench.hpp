@@ -0,0 +1,103 @@
+#ifndef str_bench_hpp
+#define str_bench_hpp
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define STR_BENCH_WARMUP 3
+#define STR_BENCH_REPS 15
+
+namespace str
+{
+
+// summary of one benchmark case; times are per repetition, each repetition doing `ops` operations
+struct BenchResult
+{
+  std::string name;
+  unsigned long objects = 0;
+  unsigned int threads = 1;
+  unsigned long ops = 0;
+  unsigned long reps = 0;
+
+  float mean_ms = 0.0f;
+  float stddev_ms = 0.0f;
+  float min_ms = 0.0f;
+  float median_ms = 0.0f;
+  float max_ms = 0.0f;
+
+  float nsPerOp() const { return ops > 0 ? median_ms * 1e6f / ops : 0.0f; }
+  float opsPerSecond() const { return median_ms > 0.0f ? ops * 1e3f / median_ms : 0.0f; }
+};
+
+// keeps the optimizer from discarding a benchmarked result
+template <typename T>
+inline void keep(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+class Bench
+{
+  public:
+    Bench(unsigned long warmup = STR_BENCH_WARMUP, unsigned long reps = STR_BENCH_REPS);
+    Bench(const Bench&) = default;
+    Bench(Bench&&) = default;
+
+    ~Bench() = default;
+
+    Bench& operator = (const Bench&) = default;
+    Bench& operator = (Bench&&) = default;
+
+    void setFilter(const std::string&);
+    void setLog(std::ostream *);
+    bool enabled(const std::string&) const;
+
+    template <typename F>
+    void run(const std::string& name, unsigned long objects, unsigned int threads, unsigned long ops, F&& body)
+    {
+      if (!enabled(name))
+        return;
+
+      for (unsigned long i = 0; i < warmup; ++i)
+        body();
+
+      std::vector<float> times(reps);
+      for (auto& time : times)
+      {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+
+        time = std::chrono::duration<float, std::milli>(end - start).count();
+      }
+
+      add(summarize(name, objects, threads, ops, times));
+    }
+
+    const std::vector<BenchResult>& results() const;
+
+    void report(std::ostream&) const;
+    void writeCSV(std::ostream&) const;
+    void writeJSON(std::ostream&) const;
+    void write(const std::string&) const;
+
+  private:
+    BenchResult summarize(const std::string&, unsigned long, unsigned int, unsigned long, std::vector<float>&) const;
+    void add(const BenchResult&);
+    void row(std::ostream&, const BenchResult&) const;
+    void header(std::ostream&) const;
+
+  private:
+    unsigned long warmup;
+    unsigned long reps;
+    std::string filter;
+    std::ostream * log = nullptr;
+
+    std::vector<BenchResult> result_array;
+};
+
+} // namespace str
+
+#endif // str_bench_hpp
@@ -0,0 +1,92 @@
+#ifndef str_buffer_hpp
+#define str_buffer_hpp
+
+#include "src/include/device.hpp"
+
+#include <functional>
+
+namespace str
+{
+
+unsigned int findMemoryIndex(const vk::raii::PhysicalDevice&, unsigned int, vk::MemoryPropertyFlags);
+bool hasSeparateHeap(const vk::raii::PhysicalDevice&);
+
+void createBuffer(
+  const Device&,
+  vk::DeviceSize,
+  vk::BufferUsageFlags,
+  vk::MemoryPropertyFlags,
+  vk::raii::Buffer&,
+  vk::raii::DeviceMemory&
+);
+
+void submitImmediate(const Device&, const std::function<void(const vk::raii::CommandBuffer&)>&);
+
+// host-visible and coherent, mapped for its whole lifetime, for small blocks rewritten every frame
+class MappedBuffer
+{
+  public:
+    MappedBuffer() = default;
+    MappedBuffer(const MappedBuffer&) = delete;
+    MappedBuffer(MappedBuffer&&) = default;
+
+    ~MappedBuffer() = default;
+
+    MappedBuffer& operator = (const MappedBuffer&) = delete;
+    MappedBuffer& operator = (MappedBuffer&&) = default;
+
+    const vk::raii::Buffer& buffer() const;
+    vk::DeviceSize size() const;
+    void * data() const;
+
+    void allocate(const Device&, vk::DeviceSize, vk::BufferUsageFlags);
+
+  private:
+    vk::DeviceSize bytes = 0;
+    void * mapped = nullptr;
+
+    vk::raii::Buffer vk_buffer = nullptr;
+    vk::raii::DeviceMemory vk_memory = nullptr;
+};
+
+class StorageBuffer
+{
+  public:
+    StorageBuffer() = default;
+    StorageBuffer(const StorageBuffer&) = delete;
+    StorageBuffer(StorageBuffer&&) = default;
+
+    ~StorageBuffer() = default;
+
+    StorageBuffer& operator = (const StorageBuffer&) = delete;
+    StorageBuffer& operator = (StorageBuffer&&) = default;
+
+    const vk::raii::Buffer& buffer() const;
+    vk::DeviceSize capacity() const;
+    void * data() const;
+    bool staged() const;
+
+    bool reserve(const Device&, vk::DeviceSize);
+    void touch(vk::DeviceSize, vk::DeviceSize);
+    void record(const vk::raii::CommandBuffer&);
+
+  private:
+    void allocate(const Device&, vk::DeviceSize);
+
+  private:
+    bool device_local = false;
+    vk::DeviceSize bytes = 0;
+    vk::DeviceSize dirty_begin = 0;
+    vk::DeviceSize dirty_end = 0;
+    void * mapped = nullptr;
+
+    vk::raii::Buffer vk_staging = nullptr;
+    vk::raii::DeviceMemory vk_stagingMemory = nullptr;
+
+    vk::raii::Buffer vk_buffer = nullptr;
+    vk::raii::DeviceMemory vk_memory = nullptr;
+};
+
+} // namespace str
+
+#endif // str_buffer_hpp
@@ -0,0 +1,63 @@
+#ifndef str_bvh_hpp
+#define str_bvh_hpp
+
+#include "src/include/transform_store.hpp"
+
+#include <vector>
+
+#define STR_BVH_LEAF_SIZE 4
+#define STR_BVH_REBUILD_RATIO 2.0f
+
+// the traversal stacks in tracer.cpp and trace.glsl hold one entry per level below the root
+#define STR_BVH_MAX_DEPTH 32
+
+namespace str
+{
+
+struct BVHNode
+{
+  float lo[3] = {};
+  unsigned int left_first = 0;
+  float hi[3] = {};
+  unsigned int count = 0;
+};
+
+static_assert(sizeof(BVHNode) == 32, "BVHNode must match the std430 layout in trace.glsl");
+
+class BVH
+{
+  public:
+    BVH() = default;
+    BVH(const BVH&) = default;
+    BVH(BVH&&) = default;
+
+    ~BVH() = default;
+
+    BVH& operator = (const BVH&) = default;
+    BVH& operator = (BVH&&) = default;
+
+    const std::vector<BVHNode>& nodes() const;
+    const std::vector<unsigned int>& indices() const;
+
+    void build(const TransformStore&);
+    void refit(const TransformStore&);
+    void refit(const TransformStore&, JobSystem&);
+    void update(const TransformStore&);
+    void update(const TransformStore&, JobSystem&);
+
+  private:
+    void bound(BVHNode&, const TransformStore&) const;
+    void merge();
+    void subdivide(unsigned int, const TransformStore&, unsigned int);
+    float area(const BVHNode&) const;
+
+  private:
+    float built_area = 0.0f;
+
+    std::vector<BVHNode> node_array;
+    std::vector<unsigned int> index_array;
+};
+
+} // namespace str
+
+#endif // str_bvh_hpp
@@ -0,0 +1,15 @@
+#ifndef str_cache_hpp
+#define str_cache_hpp
+
+#include <string>
+
+#define STR_CACHE_DIRECTORY "str"
+
+namespace str
+{
+
+std::string cachePath(const std::string&);
+
+} // namespace str
+
+#endif // str_cache_hpp
@@ -1,20 +1,31 @@
 #ifndef str_camera_hpp
 #define str_camera_hpp
 
-#include "src/include/transform.hpp"
+#include "src/include/buffer.hpp"
+#include "src/include/bvh.hpp"
+#include "src/include/frame.hpp"
+#include "src/include/geodesic.hpp"
+#include "src/include/lensing.hpp"
+#include "src/include/pipeline_cache.hpp"
+#include "src/include/relativity.hpp"
+#include "src/include/transform_store.hpp"
 
 #include <vecs/vecs.hpp>
+#include <future>
+#include <optional>
 #include <vector>
 
-#define STR_MAX_TRANSFORMS 10
+#define STR_INITIAL_TRANSFORMS 16
+#define STR_MAX_SAMPLES 1024
+#define STR_ACCUMULATION_FORMAT vk::Format::eR32G32B32A32Sfloat
+#define STR_WORKGROUP_SIZE 8
 
 namespace str
 {
 
 struct TransformSSBO
 {
-  unsigned int size;
-  std::array<Transform, STR_MAX_TRANSFORMS> transforms;
+  alignas(16) unsigned int size;
 };
 
 struct Vertex
@@ -45,36 +56,98 @@ class Camera
     const vk::raii::DescriptorSet& descriptorSet(unsigned long) const;
     const vk::raii::Buffer& vertexBuffer() const;
     const vk::raii::Buffer& indexBuffer() const;
+    const vk::raii::Pipeline& computePipeline() const;
+    const vk::raii::PipelineLayout& computePipelineLayout() const;
+    const std::array<unsigned int, 2>& workgroupSize() const;
+    vk::Image accumulationImage() const;
+    const vk::Extent2D& accumulationExtent() const;
+    unsigned long revision() const;
 
     void adjustNearPlane(float);
     void adjustFOV(float);
     void translate(la::vec<3>);
     void rotate(la::vec<3>);
-    void load(const vecs::Device&, const vecs::GUI&);
-    void updateSSBO(unsigned int, const std::vector<Transform>&);
+    void resetSamples();
+    bool converged() const;
+    FrameConstants nextFrame();
+    void updateFrame(unsigned int);
+    const Tolerances& geodesicTolerances() const;
+    void setTolerances(const Tolerances&);
+    void setBending(Bending);
+    void updateSpacetime(unsigned int, const TransformStore&);
+    std::optional<float> stepsPerRay(unsigned int);
+    void setWorkgroupSize(unsigned int, unsigned int);
+    void setView(la::vec<3> pos = { 0.0, 0.0, 0.0 }, la::vec<3> norm = { 0.0, 0.0, 1.0 });
+    void load(const Device&, const PipelineCache&, const LensingTable&);
+    void waitPipelines(PipelineCache&);
+    ObjectData * objects(const Device&, unsigned int, unsigned long);
+    Boost * boosts(const Device&, unsigned int, unsigned long);
+    void commitObjects(unsigned int, unsigned long, unsigned long);
+    void recordUploads(const vk::raii::CommandBuffer&, unsigned int);
+    void updateSSBO(const Device&, unsigned int, const TransformStore&);
+    void updateSSBO(const Device&, unsigned int, const TransformStore&, unsigned long, unsigned long);
+    void updateSSBO(const Device&, unsigned int, const TransformStore&, unsigned long, unsigned long, JobSystem&);
+    void updateBVH(const Device&, unsigned int, const BVH&);
 
   private:
-    std::vector<char> read(std::string) const;
-    std::array<vk::raii::ShaderModule, 2> shaderModules(const vecs::Device& vecs_device) const;
+    std::array<vk::raii::ShaderModule, 2> shaderModules(const Device& device) const;
     std::array<vk::PipelineShaderStageCreateInfo, 2> createInfos(const std::array<vk::raii::ShaderModule, 2>&) const;
-    unsigned int findIndex(const vk::raii::PhysicalDevice&, unsigned int, vk::MemoryPropertyFlags) const;
 
-    void setView(la::vec<3> pos = { 0.0, 0.0, 0.0 }, la::vec<3> norm = { 0.0, 0.0, 1.0 });
-    void loadPipeline(const vecs::Device&, const vecs::GUI&);
-    void allocateUniforms(const vecs::Device&);
-    void loadDescriptors(const vecs::Device&);
+    void loadLayouts(const Device&);
+    void loadPipeline(const Device&, const PipelineCache&);
+    void loadComputePipeline(const Device&, const PipelineCache&);
+    void allocateUniforms(const Device&, const LensingTable&);
+    void allocateAccumulation(const Device&);
+    void loadDescriptors(const Device&);
+    void writeDescriptor(const Device&, unsigned long);
 
   private:
     la::vec<3> npDims = la::vec<3>::zero();
     la::mat<4> view = la::mat<4>::view_matrix({ 0.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 }, { 0.0, -1.0, 0.0 });
+    unsigned int samples = 0;
+    unsigned long changes = 0;
+    std::array<unsigned int, 2> workgroup = { STR_WORKGROUP_SIZE, STR_WORKGROUP_SIZE };
 
     vk::raii::DescriptorSetLayout vk_descriptorLayout = nullptr;
     vk::raii::PipelineLayout vk_pipelineLayout = nullptr;
     vk::raii::Pipeline vk_pipeline = nullptr;
 
+    vk::raii::PipelineLayout vk_computeLayout = nullptr;
+    vk::raii::Pipeline vk_computePipeline = nullptr;
+
+    std::future<float> graphicsTask;
+    std::future<float> computeTask;
+
     vk::raii::DeviceMemory vk_memory = nullptr;
     std::vector<vk::raii::Buffer> vk_buffers;
     std::vector<vk::DeviceSize> offsets;
+    std::vector<StorageBuffer> ssbos;
+    std::vector<StorageBuffer> boostBuffers;
+    std::vector<StorageBuffer> bvhNodes;
+    std::vector<StorageBuffer> bvhIndices;
+
+    // the ray basis for the current view, derived again only after the view or near plane change
+    FrameConstants basis;
+    bool stale = true;
+    std::vector<MappedBuffer> frameBuffers;
+
+    // lenses gathered at a store revision, uploaded with the tolerances to every frame slot
+    Tolerances tolerances;
+    Bending bending = Bending::Lookup;
+    bool lookup = false;
+    std::vector<Lens> lenses;
+    std::optional<unsigned long> lensRevision;
+    std::vector<MappedBuffer> spacetimeBuffers;
+    std::vector<MappedBuffer> counterBuffers;
+
+    // read-only and shared by every frame slot
+    vk::raii::Buffer vk_lensingBuffer = nullptr;
+    vk::raii::DeviceMemory vk_lensingMemory = nullptr;
+
+    vk::Extent2D accumulation_extent;
+    vk::raii::Image vk_accumulation = nullptr;
+    vk::raii::DeviceMemory vk_accumulationMemory = nullptr;
+    vk::raii::ImageView vk_accumulationView = nullptr;
 
     vk::raii::DescriptorPool vk_descriptorPool = nullptr;
     std::vector<vk::raii::DescriptorSets> vk_descriptorSets;
@@ -0,0 +1,49 @@
+#ifndef str_device_hpp
+#define str_device_hpp
+
+#include <vecs/vecs.hpp>
+
+namespace str
+{
+
+// the handles rendering needs, either borrowed from a windowed vecs::Device or owned by a
+// surface-less device for headless rendering
+class Device
+{
+  public:
+    Device();
+    explicit Device(const vecs::Device&);
+    Device(const Device&) = delete;
+    Device(Device&&) = delete;
+
+    ~Device() = default;
+
+    Device& operator = (const Device&) = delete;
+    Device& operator = (Device&&) = delete;
+
+    const vk::raii::PhysicalDevice& physical() const;
+    const vk::raii::Device& logical() const;
+    const vk::raii::Queue& queue() const;
+    unsigned int familyIndex() const;
+
+  private:
+    void pickPhysicalDevice();
+    void createLogicalDevice();
+
+  private:
+    unsigned int family = 0;
+
+    const vk::raii::PhysicalDevice * p_physical = nullptr;
+    const vk::raii::Device * p_logical = nullptr;
+    const vk::raii::Queue * p_queue = nullptr;
+
+    vk::raii::Context vk_context;
+    vk::raii::Instance vk_instance = nullptr;
+    vk::raii::PhysicalDevice vk_physicalDevice = nullptr;
+    vk::raii::Device vk_device = nullptr;
+    vk::raii::Queue vk_queue = nullptr;
+};
+
+} // namespace str
+
+#endif // str_device_hpp
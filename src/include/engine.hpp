@@ -2,10 +2,11 @@
 #define str_engine_hpp
 
 #include "src/include/renderer.hpp"
+#include "src/include/simulation.hpp"
 
 #include <vecs/vecs.hpp>
 
-#define SAMPLE_SIZE 50
+#define STR_IDLE_WAIT 0.1
 
 namespace str
 {
@@ -13,27 +14,31 @@ namespace str
 class Engine : public vecs::Engine
 {
   public:
-    Engine() = default;
+    Engine(Backend = Backend::Graphics, unsigned int threads = std::thread::hardware_concurrency(), bool pin = false);
 
     ~Engine() = default;
 
     void load() override;
     void run() override;
 
-  private:
-    float average() const;
+    const Profiler& profile() const;
 
+  private:
     void setupECS();
     void loadComponents();
 
-
   private:
+    Backend backend;
+
     float delta_time = 0.0f;
-    float elapsed_time = 0.0f;
-    std::array<float, SAMPLE_SIZE> timings;
-    unsigned long index = 0;
 
-    std::vector<Transform> transforms;
+    std::shared_ptr<Device> device;
+    std::shared_ptr<JobSystem> jobs;
+    std::shared_ptr<PipelineCache> pipelineCache = std::make_shared<PipelineCache>();
+    std::shared_ptr<LensingTable> lensing = std::make_shared<LensingTable>();
+    std::shared_ptr<Profiler> profiler = std::make_shared<Profiler>();
+    std::shared_ptr<TransformStore> transforms = std::make_shared<TransformStore>();
+    std::shared_ptr<Simulation> simulation = std::make_shared<Simulation>();
 
     std::shared_ptr<Renderer> renderer;
 };
@@ -0,0 +1,40 @@
+#ifndef str_frame_hpp
+#define str_frame_hpp
+
+#include "src/include/linalg.hpp"
+
+#include <cstddef>
+
+namespace str
+{
+
+// the std140 Frame uniform at binding 4, rewritten for every frame in flight. the camera's part is
+// derived once per view change, so generating the ray through pixel (x, y) at sub-pixel offset o
+// is corner + (x + o.x) * dx + (y + o.y) * dy - origin, with no matrix left to invert per pixel
+struct FrameConstants
+{
+  la::mat<4> inverseView = la::mat<4>::identity();
+  alignas(16) la::vec<3> origin = la::vec<3>::zero();
+  alignas(16) la::vec<3> corner = la::vec<3>::zero();
+  alignas(16) la::vec<3> dx = la::vec<3>::zero();
+  alignas(16) la::vec<3> dy = la::vec<3>::zero();
+  float jitter[2] = { 0.0f, 0.0f };
+  unsigned int index = 0;
+  unsigned int seed = 0;
+  unsigned int extent[2] = { 0, 0 };
+};
+
+static_assert(offsetof(FrameConstants, origin) == 64, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, corner) == 80, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, dx) == 96, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, dy) == 112, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, jitter) == 128, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, index) == 136, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, seed) == 140, "FrameConstants must match the std140 Frame block in trace.glsl");
+static_assert(offsetof(FrameConstants, extent) == 144, "FrameConstants must match the std140 Frame block in trace.glsl");
+
+FrameConstants rayBasis(const la::mat<4>&, const la::vec<3>&, unsigned int, unsigned int);
+
+} // namespace str
+
+#endif // str_frame_hpp
@@ -0,0 +1,29 @@
+#ifndef str_framebuffer_hpp
+#define str_framebuffer_hpp
+
+#include "src/include/linalg.hpp"
+
+#include <string>
+#include <vector>
+
+namespace str
+{
+
+struct Framebuffer
+{
+  unsigned int width = 0;
+  unsigned int height = 0;
+  std::vector<la::vec<3>> pixels;
+
+  void resize(unsigned int, unsigned int);
+
+  la::vec<3>& operator () (unsigned int x, unsigned int y) { return pixels[y * width + x]; }
+  const la::vec<3>& operator () (unsigned int x, unsigned int y) const { return pixels[y * width + x]; }
+
+  void write(const std::string&) const;
+  float rmse(const Framebuffer&) const;
+};
+
+} // namespace str
+
+#endif // str_framebuffer_hpp
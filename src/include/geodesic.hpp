@@ -0,0 +1,96 @@
+#ifndef str_geodesic_hpp
+#define str_geodesic_hpp
+
+#include "src/include/transform_store.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#define STR_MAX_LENSES 8
+#define STR_GEODESIC_RTOL 1e-4f
+#define STR_GEODESIC_ATOL 1e-5f
+#define STR_GEODESIC_MAX_STEPS 256
+#define STR_GEODESIC_MAX_DISTANCE 1000.0f
+#define STR_GEODESIC_ESCAPE 1000.0f
+
+namespace str
+{
+
+// a point mass in geometric units (G = c = 1), so its Schwarzschild radius is 2 * mass
+struct alignas(16) Lens
+{
+  float position[3];
+  float mass;
+};
+
+static_assert(sizeof(Lens) == 16, "Lens must match the std140 vec4 lenses in trace.glsl");
+
+// error control for the Dormand-Prince integrator: a step is accepted when its error estimate is
+// below absolute + relative * the step's scale, and a ray gives up bending after steps attempts
+struct Tolerances
+{
+  float relative = STR_GEODESIC_RTOL;
+  float absolute = STR_GEODESIC_ATOL;
+  unsigned int steps = STR_GEODESIC_MAX_STEPS;
+  float distance = STR_GEODESIC_MAX_DISTANCE;
+};
+
+// Integrate follows every ray with the adaptive integrator, Lookup deflects it once per mass it
+// passes using a LensingTable, treating each mass as a thin lens
+enum class Bending : unsigned int
+{
+  Integrate,
+  Lookup
+};
+
+// the std140 Spacetime uniform at binding 5, rewritten for every frame in flight
+struct SpacetimeConstants
+{
+  Lens lenses[STR_MAX_LENSES];
+  unsigned int count;
+  float relative;
+  float absolute;
+  unsigned int steps;
+  float distance;
+  float escape;
+  Bending bending;
+};
+
+static_assert(offsetof(SpacetimeConstants, lenses) == 0, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, count) == 16 * STR_MAX_LENSES, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, relative) == 16 * STR_MAX_LENSES + 4, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, absolute) == 16 * STR_MAX_LENSES + 8, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, steps) == 16 * STR_MAX_LENSES + 12, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, distance) == 16 * STR_MAX_LENSES + 16, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, escape) == 16 * STR_MAX_LENSES + 20, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(offsetof(SpacetimeConstants, bending) == 16 * STR_MAX_LENSES + 24, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+static_assert(sizeof(SpacetimeConstants) == 16 * STR_MAX_LENSES + 32, "SpacetimeConstants must match the std140 Spacetime block in trace.glsl");
+
+// the std430 Counters buffer at binding 6, summed by every ray traced through curved space
+struct GeodesicCounters
+{
+  unsigned int rays;
+  unsigned int steps;
+};
+
+static_assert(offsetof(GeodesicCounters, steps) == 4, "GeodesicCounters must match the std430 Counters buffer in trace.glsl");
+
+// position and direction of a photon; the direction is not kept at unit length
+struct Photon
+{
+  la::vec<3> x;
+  la::vec<3> v;
+};
+
+std::vector<Lens> gatherLenses(const TransformStore&);
+SpacetimeConstants spacetimeConstants(const std::vector<Lens>&, const Tolerances&, Bending);
+
+la::vec<3> bend(const la::vec<3>&, const la::vec<3>&, const std::vector<Lens>&);
+float dormandPrince(const Photon&, const la::vec<3>&, float, const std::vector<Lens>&, Photon&, la::vec<3>&, const Tolerances&);
+float nearestLens(const la::vec<3>&, const std::vector<Lens>&);
+bool captured(const la::vec<3>&, const std::vector<Lens>&);
+bool escaped(const Photon&, const std::vector<Lens>&);
+
+} // namespace str
+
+#endif // str_geodesic_hpp
@@ -0,0 +1,55 @@
+#ifndef str_headless_hpp
+#define str_headless_hpp
+
+#include "src/include/renderer.hpp"
+
+#include <memory>
+
+#define STR_HEADLESS_MAX_FRAMES 4096
+#define STR_CONVERGED_RMSE 1e-4f
+#define STR_REFERENCE_RMSE 0.05f
+
+namespace str
+{
+
+// renders defaultScene() into an offscreen image on a device without a surface, so it runs
+// without a display and on software drivers such as lavapipe
+class Headless
+{
+  public:
+    Headless(Backend = Backend::Graphics, unsigned int threads = std::thread::hardware_concurrency(), bool pin = false);
+    Headless(const Headless&) = delete;
+    Headless(Headless&&) = delete;
+
+    ~Headless() = default;
+
+    Headless& operator = (const Headless&) = delete;
+    Headless& operator = (Headless&&) = delete;
+
+    void load();
+    unsigned long run(unsigned long);
+    const Framebuffer& result() const;
+    const Profiler& profile() const;
+
+  private:
+    unsigned int previousFrame() const;
+
+  private:
+    Backend backend;
+
+    std::shared_ptr<Device> device;
+    std::shared_ptr<JobSystem> jobs;
+    std::shared_ptr<PipelineCache> pipelineCache = std::make_shared<PipelineCache>();
+    std::shared_ptr<LensingTable> lensing = std::make_shared<LensingTable>();
+    std::shared_ptr<Offscreen> offscreen = std::make_shared<Offscreen>();
+    std::shared_ptr<Camera> camera = std::make_shared<Camera>();
+    std::shared_ptr<TransformStore> transforms = std::make_shared<TransformStore>();
+    std::shared_ptr<Renderer> renderer = std::make_shared<Renderer>();
+    std::shared_ptr<Profiler> profiler = std::make_shared<Profiler>();
+
+    Framebuffer framebuffer;
+};
+
+} // namespace str
+
+#endif // str_headless_hpp
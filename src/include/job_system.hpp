@@ -0,0 +1,102 @@
+#ifndef str_job_system_hpp
+#define str_job_system_hpp
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define STR_JOB_GRAIN 1024
+
+namespace str
+{
+
+// one unit of work; it is queued once every job it depends on has finished
+class Task
+{
+  public:
+    Task(std::function<void()> b) : body(std::move(b)) {}
+    Task(const Task&) = delete;
+    Task(Task&&) = delete;
+
+    ~Task() = default;
+
+    Task& operator = (const Task&) = delete;
+    Task& operator = (Task&&) = delete;
+
+    bool finished() const { return done.load(std::memory_order_acquire); }
+
+  private:
+    friend class JobSystem;
+
+    std::function<void()> body;
+    std::exception_ptr error;
+
+    // unfinished dependencies, plus one held by submit() until they are all registered
+    std::atomic<unsigned int> waiting = 1;
+    std::atomic<bool> done = false;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Task>> dependents;
+};
+
+using Job = std::shared_ptr<Task>;
+
+// work-stealing scheduler: every thread owns a deque it pushes to and pops from at the back,
+// while idle threads steal from the front of the others. the constructing thread is thread 0 and
+// only runs jobs while it waits, so JobSystem(1) runs everything inline on the caller
+class JobSystem
+{
+  public:
+    JobSystem(unsigned int threads = std::thread::hardware_concurrency(), bool pin = false);
+    JobSystem(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+
+    ~JobSystem();
+
+    JobSystem& operator = (const JobSystem&) = delete;
+    JobSystem& operator = (JobSystem&&) = delete;
+
+    unsigned int threads() const;
+
+    Job submit(std::function<void()>, std::initializer_list<Job> = {});
+    Job submit(std::function<void()>, const std::vector<Job>&);
+    void wait(const Job&);
+    void wait(const std::vector<Job>&);
+
+    void parallel_for(unsigned long, unsigned long, unsigned long, const std::function<void(unsigned long, unsigned long)>&);
+
+  private:
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<Job> jobs;
+    };
+
+    void work(unsigned int, bool);
+    void finish(const Job&);
+    unsigned int self() const;
+
+    void push(Job);
+    Job pop(unsigned int);
+    Job steal(unsigned int);
+    bool runOne(unsigned int);
+    void execute(const Job&);
+    void release(const Job&);
+
+  private:
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<unsigned long> queued = 0;
+    std::atomic<bool> stopping = false;
+};
+
+} // namespace str
+
+#endif // str_job_system_hpp
@@ -0,0 +1,101 @@
+#ifndef str_lensing_hpp
+#define str_lensing_hpp
+
+#include "src/include/geodesic.hpp"
+#include "src/include/job_system.hpp"
+
+#include <string>
+#include <vector>
+
+#define STR_LENSING_IMPACT 256
+#define STR_LENSING_DISTANCE 64
+#define STR_LENSING_REACH 0.5f
+#define STR_LENSING_FAR 1e5f
+#define STR_LENSING_VERSION 1
+#define STR_LENSING_PREFIX "str_lensing_"
+
+namespace str
+{
+
+// rs / b at the photon sphere, b = 3 sqrt(3) / 2 rs; rays with a larger rs / b are captured
+inline constexpr float CRITICAL_IMPACT = 0.38490018f;
+
+// deflection angle in radians and excess coordinate time in Schwarzschild radii for a ray that
+// starts at some distance from a point mass, passes it and leaves for infinity
+struct Deflection
+{
+  float angle = 0.0f;
+  float delay = 0.0f;
+};
+
+// the header of the LensingLUT buffer at binding 7, followed by impact x distance Deflections
+struct LensingSSBO
+{
+  unsigned int impact;
+  unsigned int distance;
+  float reach;
+  float padding;
+};
+
+static_assert(sizeof(Deflection) == 8, "Deflection must match the std430 vec2 in trace.glsl");
+static_assert(sizeof(LensingSSBO) == 16, "LensingSSBO must match the LensingLUT header in trace.glsl");
+
+// written at the start of the cache file; a table built with other tolerances or a different
+// layout is rebuilt
+struct LensingHeader
+{
+  char magic[4];
+  unsigned int version;
+  unsigned int impact;
+  unsigned int distance;
+  float relative;
+  float absolute;
+  unsigned int steps;
+  float reach;
+};
+
+// deflection by a Schwarzschild mass over rs / b (the impact axis, denser towards the photon
+// sphere) and rs / r0 (the distance axis, up to STR_LENSING_REACH). both axes are in units of rs,
+// so one table serves every mass; it is integrated once per tolerance and kept under cachePath()
+class LensingTable
+{
+  public:
+    LensingTable() = default;
+    LensingTable(const LensingTable&) = delete;
+    LensingTable(LensingTable&&) = delete;
+
+    ~LensingTable() = default;
+
+    LensingTable& operator = (const LensingTable&) = delete;
+    LensingTable& operator = (LensingTable&&) = delete;
+
+    bool empty() const;
+    bool hit() const;
+    unsigned int impact() const;
+    unsigned int distance() const;
+    const std::vector<Deflection>& data() const;
+    LensingSSBO header() const;
+
+    void load(const Tolerances&, JobSystem&);
+    void load(const TransformStore&, const Tolerances&, JobSystem&);
+    void build(const Tolerances&, JobSystem&);
+    void save() const;
+
+    Deflection sample(float, float) const;
+
+  private:
+    std::string filename(const Tolerances&) const;
+    LensingHeader expected(const Tolerances&) const;
+    Deflection integrate(float, float, const Tolerances&) const;
+
+  private:
+    std::string path;
+    bool loaded = false;
+    LensingHeader built{};
+
+    std::vector<Deflection> table;
+};
+
+} // namespace str
+
+#endif // str_lensing_hpp
@@ -2,84 +2,109 @@
 #define str_linalg_hpp
 
 #include "src/include/linalg_decl.hpp"
+#include "src/include/linalg_simd.hpp"
+
+#include <cmath>
+#include <stdexcept>
 
 namespace la
 {
 
 template <unsigned long N, typename T>
-vec<N, T>::vec()
-{
-  data = zero().data;
-}
+constexpr vec<N, T>::vec() : data{} {}
 
 template <unsigned long N, typename T>
-vec<N, T>::vec(std::initializer_list<T> list)
+constexpr vec<N, T>::vec(std::initializer_list<T> list) : data{}
 {
-  if (list.size() != N)
-    throw std::out_of_range("la::vec::vec() : std::initializer_list has incorrect size");
-
-  unsigned long index = 0;
-  for (const T& element : list)
-    data[index++] = element;
+  *this = list;
 }
 
 template <unsigned long N, typename T>
-vec<N, T>::vec(const std::array<T, N>& arr) : data(arr) {}
+constexpr vec<N, T>::vec(const std::array<T, N>& arr) : data(arr) {}
 
 template <unsigned long N, typename T>
 template <unsigned long M>
-vec<N, T>::vec(const vec<M, T>& v, std::array<T, N - M> vals)
+constexpr vec<N, T>::vec(const vec<M, T>& v, std::array<T, N - M> vals) : data{}
 {
-  if (M >= N)
-  {
-    throw std::out_of_range(
-      "la::vec::vec() : attempted to initialize a vector with a vector that was larger or same size"
-    );
-  }
+  static_assert(M < N, "la::vec::vec() : attempted to initialize a vector with a vector that was larger or same size");
 
   for (unsigned long i = 0; i < M; ++i)
-    data[i] = v[i];
+    data[i] = v.data[i];
 
   for (unsigned long i = 0; i < N - M; ++i)
     data[i + M] = vals[i];
 }
 
 template <unsigned long N, typename T>
-vec<N, T>& vec<N, T>::operator=(std::initializer_list<T> list)
+constexpr vec<N, T>& vec<N, T>::operator=(std::initializer_list<T> list)
 {
+#ifdef STR_LA_CHECKED
   if (list.size() != N)
     throw std::out_of_range("la::vec::operator= : std::initializer_list has incorrect size");
+#endif
 
   unsigned long index = 0;
   for (const T& element : list)
+  {
+    if (index == N) break;
     data[index++] = element;
+  }
 
   return *this;
 }
 
 template <unsigned long N, typename T>
-T& vec<N, T>::operator [] (unsigned long index)
+constexpr T& vec<N, T>::operator [] (unsigned long index)
+{
+#ifdef STR_LA_CHECKED
+  return at(index);
+#else
+  return data[index];
+#endif
+}
+
+template <unsigned long N, typename T>
+constexpr const T& vec<N, T>::operator [] (unsigned long index) const
+{
+#ifdef STR_LA_CHECKED
+  return at(index);
+#else
+  return data[index];
+#endif
+}
+
+template <unsigned long N, typename T>
+constexpr T& vec<N, T>::at(unsigned long index)
 {
   if (index > N - 1)
-    throw std::out_of_range("la::vec::operator[] : index out of range");
+    throw std::out_of_range("la::vec::at() : index out of range");
 
   return data[index];
 }
 
 template <unsigned long N, typename T>
-const T& vec<N, T>::operator [] (unsigned long index) const
+constexpr const T& vec<N, T>::at(unsigned long index) const
 {
   if (index > N - 1)
-    throw std::out_of_range("la::vec::operator[] : index out of range");
+    throw std::out_of_range("la::vec::at() : index out of range");
 
   return data[index];
 }
 
 template <unsigned long N, typename T>
-vec<N, T> vec<N, T>::operator + (const vec<N, T>& rhs) const
+constexpr vec<N, T> vec<N, T>::operator + (const vec<N, T>& rhs) const
 {
   vec<N, T> result;
 
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::store(result.data.data(), simd::add(simd::load(data.data()), simd::load(rhs.data.data())));
+      return result;
+    }
+  }
+
   for (unsigned long i = 0; i < N; ++i)
     result[i] = data[i] + rhs[i];
 
@@ -87,14 +112,30 @@ vec<N, T> vec<N, T>::operator + (const vec<N, T>& rhs) const
 }
 
 template <unsigned long N, typename T>
-vec<N, T> vec<N, T>::operator - (const vec<N, T>& rhs) const
+constexpr vec<N, T> vec<N, T>::operator - (const vec<N, T>& rhs) const
 {
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      vec<N, T> result;
+      simd::store(result.data.data(), simd::sub(simd::load(data.data()), simd::load(rhs.data.data())));
+      return result;
+    }
+  }
+
   return *this + -rhs;
 }
 
 template <unsigned long N, typename T>
-T vec<N, T>::operator * (const vec<N, T>& rhs) const
+constexpr T vec<N, T>::operator * (const vec<N, T>& rhs) const
 {
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+      return simd::dot<N>(data.data(), rhs.data.data());
+  }
+
   T result = 0;
 
   for (unsigned long i = 0; i < N; ++i)
@@ -104,10 +145,19 @@ T vec<N, T>::operator * (const vec<N, T>& rhs) const
 }
 
 template <unsigned long N, typename T>
-vec<N, T> vec<N, T>::operator / (T rhs) const
+constexpr vec<N, T> vec<N, T>::operator / (T rhs) const
 {
   vec<N, T> result;
 
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::store(result.data.data(), simd::div(simd::load(data.data()), simd::set1(rhs)));
+      return result;
+    }
+  }
+
   for (unsigned long i = 0; i < N; ++i)
     result[i] = data[i] / rhs;
 
@@ -115,10 +165,19 @@ vec<N, T> vec<N, T>::operator / (T rhs) const
 }
 
 template <unsigned long N, typename T>
-vec<N, T> vec<N, T>::operator - () const
+constexpr vec<N, T> vec<N, T>::operator - () const
 {
   vec<N, T> result;
 
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::store(result.data.data(), simd::neg(simd::load(data.data())));
+      return result;
+    }
+  }
+
   for (unsigned long i = 0; i < N; ++i)
     result[i] = -data[i];
 
@@ -127,144 +186,189 @@ vec<N, T> vec<N, T>::operator - () const
 
 template <unsigned long N, typename T>
 template <unsigned long M>
-typename std::enable_if<M == 3 && N == M, vec<M, T>>::type vec<N, T>::operator % (const vec<M, T>& rhs) const
+constexpr typename std::enable_if<M == 3 && N == M, vec<M, T>>::type vec<N, T>::operator % (const vec<M, T>& rhs) const
 {
   vec<M, T> result;
 
-  for (unsigned long i = 0, j = 1, k = 2; i < N; ++i, j = ++j % 3, k = ++k % 3)
-    result[i] = data[j] * rhs[k] - data[k] * rhs[j] * pow(-1, i);
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::cross(result.data.data(), data.data(), rhs.data.data());
+      return result;
+    }
+  }
+
+  for (unsigned long i = 0, j = 1, k = 2; i < N; ++i, j = (j + 1) % 3, k = (k + 1) % 3)
+    result[i] = data[j] * rhs[k] - data[k] * rhs[j];
 
   return result;
 }
 
 template <unsigned long N, typename T>
-vec<N, T> vec<N, T>::zero()
+constexpr vec<N, T> vec<N, T>::zero()
 {
-  std::array<T, N> arr = { 0.0 };
-  return vec<N, T>(arr);
+  return vec<N, T>();
 }
 
 template <unsigned long N, typename T>
 T vec<N, T>::norm() const
 {
-  return sqrt(*this * *this);
+  return std::sqrt(*this * *this);
 }
 
 template <unsigned long N, typename T>
 vec<N, T> vec<N, T>::normalized() const
 {
+  if constexpr (simd::accelerated<N, T>)
+  {
+    vec<N, T> result;
+    simd::normalize<N>(result.data.data(), data.data());
+    return result;
+  }
+
   return *this / norm();
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T>::mat()
-{
-  data = zeros().data;
-}
+constexpr mat<M, N, T>::mat() : data{} {}
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T>::mat(std::initializer_list<vec<M, T>> list)
+constexpr mat<M, N, T>::mat(std::initializer_list<vec<M, T>> list) : data{}
 {
   fill(list);
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T>& mat<M, N, T>::operator = (std::initializer_list<vec<M, T>> list)
+constexpr mat<M, N, T>& mat<M, N, T>::operator = (std::initializer_list<vec<M, T>> list)
 {
   fill(list);
+  return *this;
 }
 
 template <unsigned long M, unsigned long N, typename T>
-vec<M, T>& mat<M, N, T>::operator [] (unsigned long index)
+constexpr vec<M, T>& mat<M, N, T>::operator [] (unsigned long index)
 {
-  if (index > N - 1)
-    throw std::out_of_range("la::mat::col() : index out of range");
+#ifdef STR_LA_CHECKED
+  return at(index);
+#else
+  return data[index];
+#endif
+}
 
+template <unsigned long M, unsigned long N, typename T>
+constexpr const vec<M, T>& mat<M, N, T>::operator [] (unsigned long index) const
+{
+#ifdef STR_LA_CHECKED
+  return at(index);
+#else
   return data[index];
+#endif
 }
 
 template <unsigned long M, unsigned long N, typename T>
-const vec<M, T>& mat<M, N, T>::operator [] (unsigned long index) const
+constexpr vec<M, T>& mat<M, N, T>::at(unsigned long index)
 {
   if (index > N - 1)
-    throw std::out_of_range("la::mat::col() : index out of range");
+    throw std::out_of_range("la::mat::at() : index out of range");
 
   return data[index];
 }
 
 template <unsigned long M, unsigned long N, typename T>
-vec<N, T> mat<M, N, T>::operator () (unsigned long index)
+constexpr const vec<M, T>& mat<M, N, T>::at(unsigned long index) const
 {
-  if (index > M - 1)
-    throw std::out_of_range("la::mat::row() : index out of range");
-
-  vec<N, T> result;
-
-  for (unsigned long i = 0; i < N; ++i)
-    result[i] = data[i][index];
+  if (index > N - 1)
+    throw std::out_of_range("la::mat::at() : index out of range");
 
-  return result;
+  return data[index];
 }
 
 template <unsigned long M, unsigned long N, typename T>
-const vec<N, T> mat<M, N, T>::operator () (unsigned long index) const
+constexpr vec<N, T> mat<M, N, T>::operator () (unsigned long index) const
 {
+#ifdef STR_LA_CHECKED
   if (index > M - 1)
     throw std::out_of_range("la::mat::row() : index out of range");
+#endif
 
   vec<N, T> result;
 
   for (unsigned long i = 0; i < N; ++i)
-    result[i] = data[i][index];
+    result.data[i] = data[i].data[index];
 
   return result;
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::operator + (const mat<M, N, T>& rhs) const
+constexpr mat<M, N, T> mat<M, N, T>::operator + (const mat<M, N, T>& rhs) const
 {
   mat<M, N, T> result;
 
-  for (unsigned long i = 0; i < M; ++i)
+  for (unsigned long i = 0; i < N; ++i)
     result[i] = (*this)[i] + rhs[i];
 
   return result;
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::operator - (const mat<M, N, T>& rhs) const
+constexpr mat<M, N, T> mat<M, N, T>::operator - (const mat<M, N, T>& rhs) const
 {
   return *this + -rhs;
 }
 
 template <unsigned long M, unsigned long N, typename T>
 template <unsigned long P>
-mat<M, P, T> mat<M, N, T>::operator * (const mat<N, P, T>& rhs) const
+constexpr mat<M, P, T> mat<M, N, T>::operator * (const mat<N, P, T>& rhs) const
 {
   mat<M, P, T> result;
 
+  if constexpr (simd::accelerated<M, T> && simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::mat_mat<N, P>(result.data[0].data.data(), data[0].data.data(), rhs.data[0].data.data());
+      return result;
+    }
+  }
+
   for (unsigned long i = 0; i < P; ++i)
   {
-    for (unsigned long j = 0; j < M; ++j)
-      result[i][j] = (*this)(j) * rhs[i];
+    for (unsigned long k = 0; k < N; ++k)
+    {
+      for (unsigned long j = 0; j < M; ++j)
+        result.data[i].data[j] += data[k].data[j] * rhs.data[i].data[k];
+    }
   }
 
   return result;
 }
 
 template <unsigned long M, unsigned long N, typename T>
-vec<M, T> mat<M, N, T>::operator * (const vec<N, T>& rhs) const
+constexpr vec<M, T> mat<M, N, T>::operator * (const vec<N, T>& rhs) const
 {
   vec<M, T> result;
 
-  for (unsigned long i = 0; i < M; ++i)
-    result[i] = (*this)(i) * rhs;
+  if constexpr (simd::accelerated<M, T> && simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::mat_vec<N>(result.data.data(), data[0].data.data(), rhs.data.data());
+      return result;
+    }
+  }
+
+  for (unsigned long k = 0; k < N; ++k)
+  {
+    for (unsigned long j = 0; j < M; ++j)
+      result.data[j] += data[k].data[j] * rhs.data[k];
+  }
 
   return result;
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::operator / (T rhs) const
+constexpr mat<M, N, T> mat<M, N, T>::operator / (T rhs) const
 {
   mat<M, N, T> result;
 
@@ -275,7 +379,7 @@ mat<M, N, T> mat<M, N, T>::operator / (T rhs) const
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::operator - () const
+constexpr mat<M, N, T> mat<M, N, T>::operator - () const
 {
   mat<M, N, T> result;
 
@@ -286,17 +390,50 @@ mat<M, N, T> mat<M, N, T>::operator - () const
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::zeros()
-{
-  std::array<vec<M, T>, N> zeros_matrix;
-  for (unsigned long i = 0; i < N; ++i)
-    zeros_matrix[i] = vec<M, T>::zero();
+constexpr mat<M, N, T> mat<M, N, T>::inverse() const
+{
+  static_assert(M == 4 && N == 4, "inverse is only implemented for la::mat<4, 4, T>");
+
+  T m[16] = {};
+  for (unsigned long i = 0; i < 16; ++i)
+    m[i] = data[i / 4].data[i % 4];
+
+  T inv[16] = {
+    m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
+    -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10],
+    m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6],
+    -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6],
+    -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10],
+    m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10],
+    -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6],
+    m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6],
+    m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9],
+    -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9],
+    m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5],
+    -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5],
+    -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9],
+    m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9],
+    -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5],
+    m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5]
+  };
+
+  T det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+  mat<M, N, T> result;
+  for (unsigned long i = 0; i < 16; ++i)
+    result.data[i / 4].data[i % 4] = inv[i] / det;
+
+  return result;
+}
 
-  return mat<M, N, T>(zeros_matrix);
+template <unsigned long M, unsigned long N, typename T>
+constexpr mat<M, N, T> mat<M, N, T>::zeros()
+{
+  return mat<M, N, T>();
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::identity()
+constexpr mat<M, N, T> mat<M, N, T>::identity()
 {
   static_assert(M == N, "identity only produces square matrices");
 
@@ -331,7 +468,7 @@ mat<M, N, T> mat<M, N, T>::perspective_projection(T fov_y, T aspect_ratio, T nea
   static_assert(M == 4 && N == 4, "perspective_projection must be type la::mat<4, 4, T>");
 
   T delta_plane = far - near;
-  T tan_fov = tan(fov_y / 2);
+  T tan_fov = std::tan(fov_y / 2);
 
   return mat<4, 4, T>{
     vec<4, T>{ 1 / (aspect_ratio * tan_fov), 0.0, 0.0, 0.0 },
@@ -342,7 +479,7 @@ mat<M, N, T> mat<M, N, T>::perspective_projection(T fov_y, T aspect_ratio, T nea
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::scale_matrix(T s_x, T s_y, T s_z)
+constexpr mat<M, N, T> mat<M, N, T>::scale_matrix(T s_x, T s_y, T s_z)
 {
   static_assert(M == 4 && N == 4, "scale_matrix must be type la::mat<4, 4, T>");
 
@@ -355,7 +492,7 @@ mat<M, N, T> mat<M, N, T>::scale_matrix(T s_x, T s_y, T s_z)
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::translation_matrix(vec<3, T> position)
+constexpr mat<M, N, T> mat<M, N, T>::translation_matrix(vec<3, T> position)
 {
   static_assert(M == 4 && N == 4, "translation_matrix must be type la::mat<4, 4, T>");
 
@@ -371,7 +508,7 @@ mat<M, N, T> mat<M, N, T>::rotation_matrix(T theta, vec<3, T> axis)
   static_assert(M == 4 && N == 4, "rotation_matrix must be type la::mat<4, 4, T>");
 
   auto K = mat<3, 3, T>::cross_product(axis);
-  auto R = mat<3, 3, T>::identity() + sin(theta) * K + (1 - cos(theta)) * K * K;   // Rodrigues' Formula
+  auto R = mat<3, 3, T>::identity() + std::sin(theta) * K + (1 - std::cos(theta)) * K * K;   // Rodrigues' Formula
 
   return mat<4, 4, T>{
     vec<4, T>(R[0], { 0.0 }),
@@ -382,7 +519,7 @@ mat<M, N, T> mat<M, N, T>::rotation_matrix(T theta, vec<3, T> axis)
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> mat<M, N, T>::cross_product(vec<3, T> v)
+constexpr mat<M, N, T> mat<M, N, T>::cross_product(vec<3, T> v)
 {
   static_assert(M == 3 && N == 3, "cross_product must be type la::mat<3, 3, T>");
 
@@ -394,27 +531,38 @@ mat<M, N, T> mat<M, N, T>::cross_product(vec<3, T> v)
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T>::mat(const std::array<vec<M, T>, N>& arr)
-{
-  data = arr;
-}
+constexpr mat<M, N, T>::mat(const std::array<vec<M, T>, N>& arr) : data(arr) {}
 
 template <unsigned long M, unsigned long N, typename T>
-void mat<M, N, T>::fill(const std::initializer_list<vec<M, T>>& list)
+constexpr void mat<M, N, T>::fill(const std::initializer_list<vec<M, T>>& list)
 {
+#ifdef STR_LA_CHECKED
   if (list.size() != N)
     throw std::out_of_range("la::mat::fill() : std::initializer_list has incorrect dimensions");
+#endif
 
   unsigned long i = 0;
   for (const vec<M, T>& element : list)
+  {
+    if (i == N) break;
     data[i++] = element;
+  }
 }
 
 template <unsigned long N, typename T>
-vec<N, T> operator * (T lhs, const vec<N, T>& rhs)
+constexpr vec<N, T> operator * (T lhs, const vec<N, T>& rhs)
 {
   vec<N, T> result;
 
+  if constexpr (simd::accelerated<N, T>)
+  {
+    if (!std::is_constant_evaluated())
+    {
+      simd::store(result.data.data(), simd::mul(simd::set1(lhs), simd::load(rhs.data.data())));
+      return result;
+    }
+  }
+
   for (unsigned long i = 0; i < N; ++i)
     result[i] = lhs * rhs[i];
 
@@ -422,7 +570,7 @@ vec<N, T> operator * (T lhs, const vec<N, T>& rhs)
 }
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> operator * (T lhs, const mat<M, N, T>& rhs)
+constexpr mat<M, N, T> operator * (T lhs, const mat<M, N, T>& rhs)
 {
   mat<M, N, T> result;
 
@@ -433,7 +581,7 @@ mat<M, N, T> operator * (T lhs, const mat<M, N, T>& rhs)
 }
 
 template <typename T>
-T radians(T deg)
+constexpr T radians(T deg)
 {
   static_assert(std::is_same<T, double>::value || std::is_same<T, float>::value);
 
@@ -6,6 +6,10 @@
 #include <type_traits>
 #include <string>
 
+#if !defined(STR_LA_CHECKED) && !defined(NDEBUG)
+  #define STR_LA_CHECKED
+#endif
+
 namespace la
 {
 
@@ -15,41 +19,53 @@ class alignas( N == 3 && std::is_same<T, float>::value ? 16 : sizeof(T) * N ) ve
   static_assert(std::is_same<T, double>::value || std::is_same<T, float>::value);
 
   public:
-    vec();
-    vec(const vec&) = default;
-    vec(vec&&) = default;
-    vec(std::initializer_list<T>);
+    constexpr vec();
+    constexpr vec(const vec&) = default;
+    constexpr vec(vec&&) = default;
+    constexpr vec(std::initializer_list<T>);
 
     template<unsigned long M>
-    vec(const vec<M, T>&, std::array<T, N - M>);
+    constexpr vec(const vec<M, T>&, std::array<T, N - M>);
+
+    constexpr ~vec() = default;
 
-    ~vec() = default;
+    constexpr vec& operator = (const vec&) = default;
+    constexpr vec& operator = (vec&&) = default;
+    constexpr vec& operator = (std::initializer_list<T>);
 
-    vec& operator = (const vec&) = default;
-    vec& operator = (vec&&) = default;
-    vec& operator = (std::initializer_list<T>);
+    constexpr T& operator [] (unsigned long);
+    constexpr const T& operator [] (unsigned long) const;
 
-    T& operator [] (unsigned long);
-    const T& operator [] (unsigned long) const;
+    constexpr T& at(unsigned long);
+    constexpr const T& at(unsigned long) const;
 
-    vec operator + (const vec&) const;
-    vec operator - (const vec&) const;
-    T operator * (const vec&) const;
-    vec operator / (T) const;
-    vec operator - () const;
+    constexpr vec operator + (const vec&) const;
+    constexpr vec operator - (const vec&) const;
+    constexpr T operator * (const vec&) const;
+    constexpr vec operator / (T) const;
+    constexpr vec operator - () const;
 
     template <unsigned long M>
-    typename std::enable_if<M == 3 && N == M, vec<M, T>>::type operator % (const vec<M, T>&) const;
+    constexpr typename std::enable_if<M == 3 && N == M, vec<M, T>>::type operator % (const vec<M, T>&) const;
 
-    static vec zero();
+    static constexpr vec zero();
 
     T norm() const;
     vec<N, T> normalized() const;
 
   private:
-    vec(const std::array<T, N>&);
+    constexpr vec(const std::array<T, N>&);
 
   private:
+    template <unsigned long, typename>
+    friend class vec;
+
+    template <unsigned long, unsigned long, typename>
+    friend class mat;
+
+    template <unsigned long P, typename U>
+    friend constexpr vec<P, U> operator * (U, const vec<P, U>&);
+
     std::array<T, N> data;
 };
 
@@ -59,60 +75,67 @@ class alignas( alignof(vec<M, T>) ) mat
   static_assert(std::is_same<T, double>::value || std::is_same<T, float>::value);
 
   public:
-    mat();
-    mat(const mat&) = default;
-    mat(mat&&) = default;
-    mat(std::initializer_list<vec<M, T>>);
+    constexpr mat();
+    constexpr mat(const mat&) = default;
+    constexpr mat(mat&&) = default;
+    constexpr mat(std::initializer_list<vec<M, T>>);
+
+    constexpr ~mat() = default;
 
-    ~mat() = default;
+    constexpr mat& operator = (const mat&) = default;
+    constexpr mat& operator = (mat&&) = default;
+    constexpr mat& operator = (std::initializer_list<vec<M, T>>);
 
-    mat& operator = (const mat&) = default;
-    mat& operator = (mat&&) = default;
-    mat& operator = (std::initializer_list<vec<M, T>>);
+    constexpr vec<M, T>& operator [] (unsigned long index);
+    constexpr const vec<M, T>& operator [] (unsigned long index) const;
 
-    vec<M, T>& operator [] (unsigned long index);
-    const vec<M, T>& operator [] (unsigned long index) const;
+    constexpr vec<M, T>& at(unsigned long index);
+    constexpr const vec<M, T>& at(unsigned long index) const;
 
-    vec<N, T> operator () (unsigned long index);
-    const vec<N, T> operator () (unsigned long index) const;
+    constexpr vec<N, T> operator () (unsigned long index) const;
 
-    mat operator + (const mat&) const;
-    mat operator - (const mat&) const;
+    constexpr mat operator + (const mat&) const;
+    constexpr mat operator - (const mat&) const;
 
     template <unsigned long P>
-    mat<M, P, T> operator * (const mat<N, P, T>&) const;
+    constexpr mat<M, P, T> operator * (const mat<N, P, T>&) const;
 
-    vec<M, T> operator * (const vec<N, T>&) const;
-    mat operator / (T) const;
-    mat operator - () const;
+    constexpr vec<M, T> operator * (const vec<N, T>&) const;
+    constexpr mat operator / (T) const;
+    constexpr mat operator - () const;
 
-    static mat zeros();
-    static mat identity();
+    constexpr mat inverse() const;
+
+    static constexpr mat zeros();
+    static constexpr mat identity();
 
     static mat view_matrix(vec<3, T>, vec<3, T>, vec<3, T>);
     static mat perspective_projection(T, T, T, T);
-    static mat scale_matrix(T, T, T);
-    static mat translation_matrix(vec<3, T>);
+    static constexpr mat scale_matrix(T, T, T);
+    static constexpr mat translation_matrix(vec<3, T>);
     static mat rotation_matrix(T, vec<3, T>);
-    static mat cross_product(vec<3, T>);
+    static constexpr mat cross_product(vec<3, T>);
 
   private:
-    mat(const std::array<vec<M, T>, N>&);
+    constexpr mat(const std::array<vec<M, T>, N>&);
 
-    void fill(const std::initializer_list<vec<M, T>>&);
+    constexpr void fill(const std::initializer_list<vec<M, T>>&);
 
   private:
+    template <unsigned long, unsigned long, typename>
+    friend class mat;
+
     std::array<vec<M, T>, N> data;
 };
 
 template <unsigned long N, typename T>
-vec<N, T> operator * (T, const vec<N, T>&);
+constexpr vec<N, T> operator * (T, const vec<N, T>&);
 
 template <unsigned long M, unsigned long N, typename T>
-mat<M, N, T> operator * (T, const mat<M, N, T>&);
+constexpr mat<M, N, T> operator * (T, const mat<M, N, T>&);
 
 template <typename T = float>
-T radians(T deg);
+constexpr T radians(T deg);
 
 } // namespace la
 
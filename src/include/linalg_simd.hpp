@@ -0,0 +1,188 @@
+#ifndef str_linalg_simd_hpp
+#define str_linalg_simd_hpp
+
+#include <cmath>
+#include <type_traits>
+
+#if !defined(STR_LA_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+  #define STR_LA_SSE
+  #include <immintrin.h>
+#elif !defined(STR_LA_SCALAR) && defined(__ARM_NEON)
+  #define STR_LA_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace la::simd
+{
+
+#if defined(STR_LA_SSE) || defined(STR_LA_NEON)
+inline constexpr bool available = true;
+#else
+inline constexpr bool available = false;
+#endif
+
+template <unsigned long N, typename T>
+inline constexpr bool accelerated = available && std::is_same<T, float>::value && (N == 3 || N == 4);
+
+#if defined(STR_LA_SSE)
+
+using f4 = __m128;
+
+inline f4 load(const float * p) { return _mm_load_ps(p); }
+inline void store(float * p, f4 v) { _mm_store_ps(p, v); }
+inline f4 set1(float s) { return _mm_set1_ps(s); }
+inline f4 add(f4 a, f4 b) { return _mm_add_ps(a, b); }
+inline f4 sub(f4 a, f4 b) { return _mm_sub_ps(a, b); }
+inline f4 mul(f4 a, f4 b) { return _mm_mul_ps(a, b); }
+inline f4 div(f4 a, f4 b) { return _mm_div_ps(a, b); }
+inline f4 neg(f4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+#if defined(__FMA__)
+inline f4 madd(f4 a, f4 b, f4 c) { return _mm_fmadd_ps(a, b, c); }
+#else
+inline f4 madd(f4 a, f4 b, f4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+template <unsigned int L>
+inline f4 splat(f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(L, L, L, L)); }
+
+inline f4 yzx(f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+inline f4 zxy(f4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); }
+
+inline f4 xyz(f4 v)
+{
+  return _mm_and_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+}
+
+inline float hsum(f4 v)
+{
+  f4 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+  f4 sums = _mm_add_ps(v, shuf);
+  shuf = _mm_movehl_ps(shuf, sums);
+  return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+
+#elif defined(STR_LA_NEON)
+
+using f4 = float32x4_t;
+
+inline f4 load(const float * p) { return vld1q_f32(p); }
+inline void store(float * p, f4 v) { vst1q_f32(p, v); }
+inline f4 set1(float s) { return vdupq_n_f32(s); }
+inline f4 add(f4 a, f4 b) { return vaddq_f32(a, b); }
+inline f4 sub(f4 a, f4 b) { return vsubq_f32(a, b); }
+inline f4 mul(f4 a, f4 b) { return vmulq_f32(a, b); }
+inline f4 div(f4 a, f4 b) { return vdivq_f32(a, b); }
+inline f4 neg(f4 a) { return vnegq_f32(a); }
+inline f4 madd(f4 a, f4 b, f4 c) { return vfmaq_f32(c, a, b); }
+
+template <unsigned int L>
+inline f4 splat(f4 v) { return vdupq_laneq_f32(v, L); }
+
+inline f4 yzx(f4 v)
+{
+  float32x4_t r = vextq_f32(v, v, 1);
+  return vsetq_lane_f32(vgetq_lane_f32(v, 3), r, 3);
+}
+
+inline f4 zxy(f4 v)
+{
+  return yzx(yzx(v));
+}
+
+inline f4 xyz(f4 v) { return vsetq_lane_f32(0.0f, v, 3); }
+inline float hsum(f4 v) { return vaddvq_f32(v); }
+
+#endif
+
+#if defined(STR_LA_SSE) || defined(STR_LA_NEON)
+
+// vec<3, float> is padded to 16 bytes, so the fourth lane of a load is padding and is masked out
+// wherever it could leak into a result
+
+template <unsigned long N>
+inline float dot(const float * a, const float * b)
+{
+  f4 product = mul(load(a), load(b));
+  return hsum(N == 3 ? xyz(product) : product);
+}
+
+inline void cross(float * out, const float * a, const float * b)
+{
+  f4 va = load(a);
+  f4 vb = load(b);
+  store(out, xyz(sub(mul(yzx(va), zxy(vb)), mul(zxy(va), yzx(vb)))));
+}
+
+template <unsigned long N>
+inline void normalize(float * out, const float * a)
+{
+  f4 v = load(a);
+  store(out, div(v, set1(std::sqrt(dot<N>(a, a)))));
+}
+
+template <unsigned long N>
+inline f4 column_sum(const float * cols, const float * v)
+{
+  constexpr unsigned long stride = 4;
+
+  f4 x = load(v);
+  f4 result = mul(load(cols), splat<0>(x));
+
+  if constexpr (N > 1) result = madd(load(cols + stride), splat<1>(x), result);
+  if constexpr (N > 2) result = madd(load(cols + 2 * stride), splat<2>(x), result);
+  if constexpr (N > 3) result = madd(load(cols + 3 * stride), splat<3>(x), result);
+
+  return result;
+}
+
+template <unsigned long N>
+inline void mat_vec(float * out, const float * cols, const float * v)
+{
+  store(out, column_sum<N>(cols, v));
+}
+
+template <unsigned long N, unsigned long P>
+inline void mat_mat(float * out, const float * lhs, const float * rhs)
+{
+  constexpr unsigned long stride = 4;
+
+  for (unsigned long i = 0; i < P; ++i)
+    store(out + i * stride, column_sum<N>(lhs, rhs + i * stride));
+}
+
+#else
+
+// without a vector backend accelerated is always false and linalg.hpp takes its generic loops. the
+// kernels stay declared so its discarded branches still name something, and are deleted so any
+// call that does survive fails to compile rather than to link, whatever the optimization level
+
+struct f4;
+
+f4 load(const float *) = delete;
+void store(float *, f4) = delete;
+f4 set1(float) = delete;
+f4 add(f4, f4) = delete;
+f4 sub(f4, f4) = delete;
+f4 mul(f4, f4) = delete;
+f4 div(f4, f4) = delete;
+f4 neg(f4) = delete;
+
+template <unsigned long N>
+float dot(const float *, const float *) = delete;
+void cross(float *, const float *, const float *) = delete;
+
+template <unsigned long N>
+void normalize(float *, const float *) = delete;
+
+template <unsigned long N>
+void mat_vec(float *, const float *, const float *) = delete;
+
+template <unsigned long N, unsigned long P>
+void mat_mat(float *, const float *, const float *) = delete;
+
+#endif
+
+} // namespace la::simd
+
+#endif // str_linalg_simd_hpp
@@ -0,0 +1,39 @@
+#ifndef str_object_hpp
+#define str_object_hpp
+
+#include "src/include/linalg.hpp"
+
+#include "shaders/object.h"
+
+#include <cstddef>
+
+namespace str
+{
+
+// the GLSL types shaders/object.h names, as laid out by std430
+namespace glsl
+{
+  using vec4 = la::vec<4>;
+  using uint = unsigned int;
+}
+
+#define STR_OBJECT_MEMBER(type, name, offset) glsl::type name;
+#define STR_OBJECT_OFFSET(type, name, offset) \
+  static_assert(offsetof(ObjectData, name) == offset, "ObjectData::" #name " must match its offset in shaders/object.h");
+
+// what TransformStore::pack() writes for the shaders: only what a ray reads, in half the size of
+// the TransformData it comes from
+struct alignas(16) ObjectData
+{
+  STR_OBJECT_FIELDS(STR_OBJECT_MEMBER)
+};
+
+STR_OBJECT_FIELDS(STR_OBJECT_OFFSET)
+static_assert(sizeof(ObjectData) == STR_OBJECT_SIZE, "ObjectData must match the std430 stride of Object in trace.glsl");
+
+#undef STR_OBJECT_MEMBER
+#undef STR_OBJECT_OFFSET
+
+} // namespace str
+
+#endif // str_object_hpp
@@ -0,0 +1,57 @@
+#ifndef str_offscreen_hpp
+#define str_offscreen_hpp
+
+#include "src/include/device.hpp"
+#include "src/include/framebuffer.hpp"
+
+#include <vector>
+
+namespace str
+{
+
+// color and depth attachments standing in for the swapchain, with one host-visible readback
+// buffer per frame in flight
+class Offscreen
+{
+  public:
+    Offscreen() = default;
+    Offscreen(const Offscreen&) = delete;
+    Offscreen(Offscreen&&) = delete;
+
+    ~Offscreen() = default;
+
+    Offscreen& operator = (const Offscreen&) = delete;
+    Offscreen& operator = (Offscreen&&) = delete;
+
+    const vk::Extent2D& extent() const;
+    vk::Image image() const;
+    const vk::raii::ImageView& imageView() const;
+    const vk::raii::ImageView& depthView() const;
+
+    void load(const Device&, vk::Extent2D);
+    void recordReadback(const vk::raii::CommandBuffer&, unsigned int) const;
+    void read(unsigned int, Framebuffer&) const;
+
+  private:
+    void createImage(const Device&, vk::Format, vk::ImageUsageFlags, vk::ImageAspectFlags,
+                     vk::raii::Image&, vk::raii::DeviceMemory&, vk::raii::ImageView&) const;
+
+  private:
+    vk::Extent2D dimensions;
+
+    vk::raii::Image vk_color = nullptr;
+    vk::raii::DeviceMemory vk_colorMemory = nullptr;
+    vk::raii::ImageView vk_colorView = nullptr;
+
+    vk::raii::Image vk_depth = nullptr;
+    vk::raii::DeviceMemory vk_depthMemory = nullptr;
+    vk::raii::ImageView vk_depthView = nullptr;
+
+    std::vector<vk::raii::Buffer> vk_readbacks;
+    std::vector<vk::raii::DeviceMemory> vk_readbackMemories;
+    std::vector<void *> mapped;
+};
+
+} // namespace str
+
+#endif // str_offscreen_hpp
@@ -0,0 +1,64 @@
+#ifndef str_pipeline_cache_hpp
+#define str_pipeline_cache_hpp
+
+#include "src/include/device.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define STR_PIPELINE_CACHE_PREFIX "str_pipeline_"
+
+namespace str
+{
+
+// VK_PIPELINE_CACHE_HEADER_VERSION_ONE, as written at the start of every cache blob
+struct PipelineCacheHeader
+{
+  unsigned int size;
+  unsigned int version;
+  unsigned int vendor;
+  unsigned int device;
+  unsigned char uuid[VK_UUID_SIZE];
+};
+
+static_assert(sizeof(PipelineCacheHeader) == 32, "PipelineCacheHeader must match the Vulkan cache header");
+
+// a vk::PipelineCache persisted between launches in a file under cachePath() named after the
+// device's cache UUID and driver version; data written by any other device or driver is discarded
+class PipelineCache
+{
+  public:
+    PipelineCache() = default;
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache(PipelineCache&&) = delete;
+
+    ~PipelineCache() = default;
+
+    PipelineCache& operator = (const PipelineCache&) = delete;
+    PipelineCache& operator = (PipelineCache&&) = delete;
+
+    const vk::raii::PipelineCache& cache() const;
+    bool hit() const;
+
+    void load(const Device&);
+    void save() const;
+
+    void record(float);
+    void report(std::ostream&) const;
+
+  private:
+    std::string filename(const vk::PhysicalDeviceProperties&) const;
+    bool valid(const std::vector<char>&, const vk::PhysicalDeviceProperties&) const;
+
+  private:
+    std::string path;
+    bool loaded = false;
+    float creation_ms = 0.0f;
+
+    vk::raii::PipelineCache vk_cache = nullptr;
+};
+
+} // namespace str
+
+#endif // str_pipeline_cache_hpp
@@ -0,0 +1,102 @@
+#ifndef str_profiler_hpp
+#define str_profiler_hpp
+
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define STR_PROFILE_WINDOW 1024
+
+namespace str
+{
+
+enum class Phase : unsigned int
+{
+  Acquire,
+  Upload,
+  Record,
+  Submit,
+  Present,
+  FenceWait,
+  Gpu,
+  Frame,
+  Steps,
+  Count
+};
+
+const char * phaseName(Phase);
+
+struct Percentiles
+{
+  unsigned long count = 0;
+  float p50 = 0.0f;
+  float p95 = 0.0f;
+  float p99 = 0.0f;
+  float max = 0.0f;
+};
+
+// the most recent samples of one measurement, oldest overwritten first
+class RollingWindow
+{
+  public:
+    RollingWindow(unsigned long capacity = STR_PROFILE_WINDOW);
+
+    void push(float);
+    void clear();
+    Percentiles percentiles() const;
+
+  private:
+    std::vector<float> samples;
+    unsigned long next = 0;
+    unsigned long filled = 0;
+};
+
+// per-phase frame timings in milliseconds
+class Profiler
+{
+  public:
+    class Scope
+    {
+      public:
+        Scope(Profiler&, Phase);
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+
+        ~Scope();
+
+        Scope& operator = (const Scope&) = delete;
+        Scope& operator = (Scope&&) = delete;
+
+      private:
+        Profiler& profiler;
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    Profiler() = default;
+    Profiler(const Profiler&) = default;
+    Profiler(Profiler&&) = default;
+
+    ~Profiler() = default;
+
+    Profiler& operator = (const Profiler&) = default;
+    Profiler& operator = (Profiler&&) = default;
+
+    Scope scope(Phase);
+    void record(Phase, float);
+    Percentiles percentiles(Phase) const;
+
+    void report(std::ostream&) const;
+    void writeCSV(std::ostream&) const;
+    void writeJSON(std::ostream&) const;
+    void write(const std::string&) const;
+
+  private:
+    std::array<RollingWindow, static_cast<unsigned long>(Phase::Count)> windows;
+};
+
+} // namespace str
+
+#endif // str_profiler_hpp
@@ -0,0 +1,34 @@
+#ifndef str_relativity_hpp
+#define str_relativity_hpp
+
+#include "src/include/job_system.hpp"
+#include "src/include/transform_store.hpp"
+
+#define STR_MAX_SPEED 0.999f
+#define STR_RELATIVITY_HORIZON 1000.0f
+
+namespace str
+{
+
+// the std430 Boost record at binding 8, one per object slot. matrix is the Lorentz boost taking an
+// event (x - position, t) in the camera's frame into the object's rest frame; motion is the
+// object's velocity in units of c with its Lorentz factor in w. both are derived once per upload,
+// so a ray only pays two matrix products and a dot product per moving object it tests
+struct Boost
+{
+  la::mat<4> matrix = la::mat<4>::identity();
+  la::vec<4> motion = { 0.0f, 0.0f, 0.0f, 1.0f };
+};
+
+static_assert(sizeof(Boost) == 80, "Boost must match the std430 layout in trace.glsl");
+
+Boost boost(const la::vec<3>&);
+void computeBoosts(const TransformStore&, Boost *, unsigned long, unsigned long);
+void computeBoosts(const TransformStore&, Boost *, unsigned long, unsigned long, JobSystem&);
+
+float doppler(const Boost&, const la::vec<3>&);
+la::vec<3> shift(const la::vec<3>&, float);
+
+} // namespace str
+
+#endif // str_relativity_hpp
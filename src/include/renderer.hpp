@@ -2,9 +2,12 @@
 #define str_renderer_hpp
 
 #include "src/include/camera.hpp"
+#include "src/include/offscreen.hpp"
+#include "src/include/profiler.hpp"
 
 #include <vecs/vecs.hpp>
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -13,6 +16,14 @@
 namespace str
 {
 
+// Graphics rasterizes a fullscreen quad that traces per fragment, Compute dispatches camera.comp
+// over the accumulation image and blits it to the target
+enum class Backend
+{
+  Graphics,
+  Compute
+};
+
 class Renderer : public vecs::System
 {
   public:
@@ -25,35 +36,74 @@ class Renderer : public vecs::System
     Renderer& operator = (const Renderer&) = delete;
     Renderer& operator = (Renderer&&) = delete;
 
-    void update(const std::shared_ptr<vecs::ComponentManager>&, std::set<unsigned long>) override;
+    void update(const std::shared_ptr<vecs::ComponentManager>&, const std::set<unsigned long>&) override;
+    void draw(Camera&);
+    bool converged(const Camera&) const;
 
-    void waitFlight() const;
+    void waitFlight();
     const unsigned int& currentFrame() const;
 
-    void link(std::shared_ptr<vecs::Device>, std::shared_ptr<vecs::GUI>);
+    void link(std::shared_ptr<Device>, std::shared_ptr<vecs::Device>, std::shared_ptr<vecs::GUI>);
+    void link(std::shared_ptr<Device>, std::shared_ptr<Offscreen>);
     void initialize();
     void setCamera(unsigned long);
+    void setTransforms(std::shared_ptr<TransformStore>);
+    void setBackend(Backend);
+    void setProfiler(std::shared_ptr<Profiler>);
+    void setJobs(std::shared_ptr<JobSystem>);
 
   private:
-    void checkResult(const vk::Result&, std::string) const;
-
-    void begin(unsigned int);
-    void render(std::shared_ptr<vecs::ComponentManager>, unsigned int);
-    void end(unsigned int);
+    void checkResult(const vk::Result&, std::string);
+    vk::Extent2D extent() const;
+    vk::Image target(unsigned int) const;
+    unsigned int targetCount() const;
+    void invalidate();
+    void readTimestamps();
+
+    void recordFrame(Camera&);
+    void recordTrace(Camera&, unsigned int, const vk::raii::CommandBuffer&);
+    void begin(const vk::raii::CommandBuffer&, unsigned int);
+    void render(const vk::raii::CommandBuffer&, Camera&, unsigned int);
+    void dispatch(const vk::raii::CommandBuffer&, Camera&, unsigned int);
+    void end(const vk::raii::CommandBuffer&, unsigned int);
 
   private:
     unsigned int frame = 0;
+    Backend backend = Backend::Graphics;
     unsigned long camera_id;
+    std::shared_ptr<TransformStore> transforms;
+    unsigned long revision = 0;
+    BVH bvh;
+
+    // store revisions already uploaded to each frame slot, and the slots changed since
+    std::vector<SlotRange> pending;
+    std::vector<std::optional<unsigned long>> ssboUploads;
+    std::vector<std::optional<unsigned long>> bvhUploads;
+    std::optional<unsigned long> built;
 
     std::vector<vk::raii::Fence> flightFences;
     std::vector<vk::raii::Semaphore> imageSemaphores;
     std::vector<vk::raii::Semaphore> renderSemaphores;
 
+    std::shared_ptr<Device> device;
+    std::shared_ptr<Offscreen> offscreen;
     std::shared_ptr<vecs::GUI> vecs_gui;
     std::shared_ptr<vecs::Device> vecs_device;
 
     vk::raii::CommandPool vk_commandPool = nullptr;
     vk::raii::CommandBuffers vk_commandBuffers = nullptr;
+
+    // one trace per frame slot and target image, recorded against a Camera::revision()
+    unsigned int targets = 1;
+    vk::raii::CommandBuffers vk_traceBuffers = nullptr;
+    std::vector<std::optional<unsigned long>> recordings;
+
+    std::shared_ptr<JobSystem> jobs = std::make_shared<JobSystem>(1);
+
+    std::shared_ptr<Profiler> profiler = std::make_shared<Profiler>();
+    float timestampPeriod = 0.0f;
+    std::vector<vk::raii::QueryPool> vk_queryPools;
+    std::vector<bool> timed;
 };
 
 } // namespace str
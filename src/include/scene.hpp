@@ -0,0 +1,23 @@
+#ifndef str_scene_hpp
+#define str_scene_hpp
+
+#include "src/include/transform.hpp"
+
+#include <vector>
+
+namespace str
+{
+
+// objects shared by the interactive engine and the CPU reference tracer
+std::vector<Transform> defaultScene();
+
+// count spheres on a cubic lattice in front of the default camera, for scaling measurements
+std::vector<Transform> gridScene(unsigned long count);
+
+// the default sphere seen past a dark point mass between it and the camera, which bends it into
+// an Einstein ring
+std::vector<Transform> lensScene();
+
+} // namespace str
+
+#endif // str_scene_hpp
@@ -0,0 +1,92 @@
+#ifndef str_simulation_hpp
+#define str_simulation_hpp
+
+#include "src/include/transform_store.hpp"
+#include "src/include/triple_buffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace str
+{
+
+struct CameraPose
+{
+  la::vec<3> position;
+  la::vec<3> direction;
+};
+
+// what the render thread draws one frame from; transforms carries the slots changed since the
+// newest snapshot the renderer had acquired when this one was written, and camera the newest pose
+// set since then
+struct Snapshot
+{
+  std::shared_ptr<TransformStore> transforms = std::make_shared<TransformStore>();
+  std::optional<CameraPose> camera;
+  unsigned long tick = 0;
+  float elapsed = 0.0f;
+};
+
+// advances the scene on its own thread, at most depth ticks ahead of the frames rendered, and
+// hands each tick to the render thread through a TripleBuffer
+class Simulation
+{
+  public:
+    using Step = std::function<void(TransformStore&, std::optional<CameraPose>&, float, float)>;
+
+    Simulation() = default;
+    Simulation(const Simulation&) = delete;
+    Simulation(Simulation&&) = delete;
+
+    ~Simulation();
+
+    Simulation& operator = (const Simulation&) = delete;
+    Simulation& operator = (Simulation&&) = delete;
+
+    void start(const TransformStore&, Step, unsigned long);
+    void stop();
+
+    const Snapshot * acquire();
+    void release();
+
+  private:
+    // what one tick changed, kept until the renderer has acquired that tick or a later one
+    struct TickChanges
+    {
+      unsigned long tick;
+      SlotRange slots;
+      std::optional<CameraPose> camera;
+    };
+
+    void run();
+    void publish(float);
+
+  private:
+    Step step;
+    unsigned long depth = 1;
+
+    TransformStore world;
+    std::optional<CameraPose> pose;
+    std::deque<TickChanges> unseen;
+
+    TripleBuffer<Snapshot> snapshots;
+
+    // per snapshot slot, the world's slots changed since that slot's store was last written, or
+    // nothing when the store must be copied whole
+    std::array<std::optional<SlotRange>, 3> stale;
+
+    std::atomic<unsigned long> ticks = 0;
+    std::atomic<unsigned long> rendered = 0;
+    std::atomic<unsigned long> acquired = 0;
+    std::atomic<bool> running = false;
+    std::thread worker;
+};
+
+} // namespace str
+
+#endif // str_simulation_hpp
@@ -0,0 +1,107 @@
+#ifndef str_tracer_hpp
+#define str_tracer_hpp
+
+#include "src/include/bvh.hpp"
+#include "src/include/frame.hpp"
+#include "src/include/framebuffer.hpp"
+#include "src/include/geodesic.hpp"
+#include "src/include/job_system.hpp"
+#include "src/include/lensing.hpp"
+#include "src/include/relativity.hpp"
+#include "src/include/transform_store.hpp"
+
+#include <atomic>
+#include <vector>
+
+#define STR_TILE_SIZE 16
+#define STR_MAX_BOUNCES 1
+#define STR_STACK_SIZE STR_BVH_MAX_DEPTH
+
+namespace str
+{
+
+struct TraceStats
+{
+  unsigned long rays = 0;
+  unsigned long steps = 0;
+  float seconds = 0.0f;
+  unsigned int threads = 0;
+
+  float raysPerSecond() const { return seconds > 0.0f ? rays / seconds : 0.0f; }
+  float stepsPerRay() const { return rays > 0 ? static_cast<float>(steps) / rays : 0.0f; }
+  float raysPerSecondPerCore() const { return threads > 0 ? raysPerSecond() / threads : 0.0f; }
+};
+
+// CPU mirror of the ray generation, traversal, lensing and shading in trace.glsl, which both the
+// fragment and compute backends trace with; --compare checks its output against a headless render
+class Tracer
+{
+  public:
+    Tracer(JobSystem&, unsigned int tile = STR_TILE_SIZE);
+    Tracer(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+
+    ~Tracer() = default;
+
+    Tracer& operator = (const Tracer&) = delete;
+    Tracer& operator = (Tracer&&) = delete;
+
+    unsigned int threads() const;
+    void setTolerances(const Tolerances&);
+    void setLensing(const LensingTable *);
+
+    TraceStats render(Framebuffer&, const la::mat<4>&, const la::vec<3>&, const TransformStore&, const BVH&);
+
+  private:
+    // time is when the light was at origin, counting back from 0 as it reaches the camera
+    struct Ray
+    {
+      la::vec<3> origin;
+      la::vec<3> dir;
+      la::vec<3> color;
+      float time = 0.0f;
+    };
+
+    struct HitInfo
+    {
+      bool hit = false;
+      bool absorbed = false;
+      float t = 0.0f;
+      la::vec<3> point = la::vec<3>::zero();
+      la::vec<3> normal = la::vec<3>::zero();
+      la::vec<3> color = la::vec<3>::zero();
+    };
+
+    void renderTile(unsigned long, unsigned long&, unsigned long&) const;
+
+    HitInfo raySphere(unsigned long, const Ray&) const;
+    HitInfo rayMovingSphere(unsigned long, const Ray&) const;
+    float rayBox(const BVHNode&, const Ray&, const la::vec<3>&, float) const;
+    HitInfo intersect(const Ray&, float) const;
+    HitInfo deflect(Ray&, unsigned long&) const;
+    HitInfo propagate(Ray&, unsigned long&) const;
+    Ray trace(Ray, unsigned long&, unsigned long&) const;
+
+  private:
+    JobSystem& jobs;
+    unsigned int tile_size;
+    unsigned long tiles_x = 0;
+    unsigned long tile_count = 0;
+
+    Framebuffer * target = nullptr;
+    const TransformStore * store = nullptr;
+    const BVH * bvh = nullptr;
+    FrameConstants basis;
+
+    Tolerances tolerances;
+    const LensingTable * lensing = nullptr;
+    std::vector<Lens> lenses;
+    std::vector<Boost> boosts;
+
+    std::atomic<unsigned long> ray_count = 0;
+    std::atomic<unsigned long> step_count = 0;
+};
+
+} // namespace str
+
+#endif // str_tracer_hpp
@@ -11,10 +11,19 @@ struct Material
   la::vec<3> color;
 };
 
+struct TransformData
+{
+  alignas(16) la::vec<3> position = { 0.0, 0.0, 0.0 };
+  alignas(16) la::vec<3> rotation = { 0.0, 0.0, 0.0 };
+  alignas(16) la::vec<3> size = { 1.0, 1.0, 1.0 };
+  alignas(16) la::vec<3> color = { 0.0, 1.0, 0.0 };
+};
+
 class Transform
 {
   public:
     Transform(la::vec<3> c = { 0.0, 1.0, 0.0 });
+    explicit Transform(const TransformData&);
     Transform(const Transform&) = default;
     Transform(Transform&&) = default;
 
@@ -23,21 +32,38 @@ class Transform
     Transform& operator = (const Transform&) = default;
     Transform& operator = (Transform&&) = default;
 
-    const la::mat<4> model() const;
+    const la::mat<4>& model() const;
+    const la::mat<4>& inverse() const;
 
     Transform& scale(la::vec<3>);
     Transform& translate(float, la::vec<3>);
     Transform& rotate(la::vec<3>);
+    Transform& mass(float);
+    Transform& velocity(la::vec<3>);
+
+    const la::vec<3>& pos() const { return state.position; }
+    const TransformData& data() const { return state; }
+    float mass() const { return weight; }
+    const la::vec<3>& velocity() const { return vel; }
 
-    const la::vec<3>& pos() const { return position; }
+  private:
+    void rebuild();
 
   private:
-    alignas(16) la::vec<3> position = { 0.0, 0.0, 0.0 };
-    alignas(16) la::vec<3> rotation = { 0.0, 0.0, 0.0 };
-    alignas(16) la::vec<3> size = { 1.0, 1.0, 1.0 };
-    alignas(16) la::vec<3> color = { 0.0, 1.0, 0.0 };
+    TransformData state;
+
+    // bends light passing by in geometric units, and stays on the CPU: lenses reach the shaders
+    // through the Spacetime uniform rather than the object buffer
+    float weight = 0.0f;
+
+    // in units of c, and only changes how the object is seen: whatever animates the scene still
+    // moves it. the shaders get it as the boost that computeBoosts() derives from it
+    la::vec<3> vel = la::vec<3>::zero();
+
+    la::mat<4> cached_model;
+    la::mat<4> cached_inverse;
 };
 
 } // namespace str
 
-#endif // str_transform_hpp
\ No newline at end of file
+#endif // str_transform_hpp
@@ -0,0 +1,127 @@
+#ifndef str_transform_store_hpp
+#define str_transform_store_hpp
+
+#include "src/include/job_system.hpp"
+#include "src/include/object.hpp"
+#include "src/include/transform.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#define STR_STORE_ALIGNMENT 64
+
+namespace str
+{
+
+template <typename T, unsigned long A = STR_STORE_ALIGNMENT>
+class AlignedAllocator
+{
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, A>; };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, A>&) {}
+
+    T * allocate(unsigned long n)
+    {
+      return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(A)));
+    }
+
+    void deallocate(T * p, unsigned long)
+    {
+      ::operator delete(p, std::align_val_t(A));
+    }
+
+    template <typename U>
+    bool operator == (const AlignedAllocator<U, A>&) const { return true; }
+};
+
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+// the half-open run of slots [first, last) touched since it was last taken
+struct SlotRange
+{
+  unsigned long first = 0;
+  unsigned long last = 0;
+
+  bool empty() const { return first == last; }
+
+  void merge(unsigned long, unsigned long);
+  void merge(const SlotRange& range) { merge(range.first, range.last); }
+};
+
+class TransformStore
+{
+  public:
+    TransformStore() = default;
+    TransformStore(const TransformStore&) = default;
+    TransformStore(TransformStore&&) = default;
+
+    ~TransformStore() = default;
+
+    TransformStore& operator = (const TransformStore&) = default;
+    TransformStore& operator = (TransformStore&&) = default;
+
+    unsigned long size() const;
+    bool contains(unsigned long) const;
+    unsigned long slot(unsigned long) const;
+    unsigned long entity(unsigned long) const;
+    unsigned long revision() const;
+    unsigned long layout() const;
+    SlotRange takeChanges();
+    void keepChanges(const SlotRange&);
+    void copy(const TransformStore&, const SlotRange&);
+
+    void insert(unsigned long, const Transform&);
+    void erase(unsigned long);
+    void set(unsigned long, const Transform&);
+    Transform get(unsigned long) const;
+
+    void translate(unsigned long, unsigned long, float, la::vec<3>);
+    void translate(unsigned long, std::span<const la::vec<3>>);
+    void rotate(unsigned long, unsigned long, la::vec<3>);
+    void scale(unsigned long, unsigned long, la::vec<3>);
+
+    void pack(ObjectData *) const;
+    void pack(ObjectData *, unsigned long, unsigned long) const;
+    void pack(ObjectData *, unsigned long, unsigned long, JobSystem&) const;
+
+    const aligned_vector<la::vec<3>>& positions() const { return pos_array; }
+    const aligned_vector<la::vec<3>>& rotations() const { return rot_array; }
+    const aligned_vector<la::vec<3>>& sizes() const { return size_array; }
+    const aligned_vector<la::vec<3>>& colors() const { return color_array; }
+    const aligned_vector<float>& masses() const { return mass_array; }
+    const aligned_vector<la::vec<3>>& velocities() const { return vel_array; }
+
+  private:
+    void check(unsigned long, unsigned long) const;
+    void mark(unsigned long, unsigned long);
+
+  private:
+    unsigned long changes = 0;
+    unsigned long layout_changes = 0;
+    SlotRange dirty;
+
+    aligned_vector<la::vec<3>> pos_array;
+    aligned_vector<la::vec<3>> rot_array;
+    aligned_vector<la::vec<3>> size_array;
+    aligned_vector<la::vec<3>> color_array;
+    aligned_vector<float> mass_array;
+    aligned_vector<la::vec<3>> vel_array;
+
+    std::vector<unsigned long> entities;
+    std::unordered_map<unsigned long, unsigned long> slots;
+};
+
+} // namespace str
+
+#endif // str_transform_store_hpp
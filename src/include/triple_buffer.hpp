@@ -0,0 +1,62 @@
+#ifndef str_triple_buffer_hpp
+#define str_triple_buffer_hpp
+
+#include <array>
+#include <atomic>
+
+namespace str
+{
+
+// single producer, single consumer handoff of the newest value: the producer fills back() and
+// publishes it, the consumer picks up whatever was published last, and neither side ever waits
+template <typename T>
+class TripleBuffer
+{
+  public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer(TripleBuffer&&) = delete;
+
+    ~TripleBuffer() = default;
+
+    TripleBuffer& operator = (const TripleBuffer&) = delete;
+    TripleBuffer& operator = (TripleBuffer&&) = delete;
+
+    T& back() { return slots[back_index]; }
+    unsigned int backIndex() const { return back_index; }
+    const T& front() const { return slots[front_index]; }
+
+    // true when the value handed back to the producer was published but never consumed, so its
+    // contents were skipped by the consumer
+    bool publish()
+    {
+      unsigned int previous = middle.exchange(back_index | FRESH, std::memory_order_acq_rel);
+      back_index = previous & INDEX;
+      return previous & FRESH;
+    }
+
+    // true when front() changed
+    bool update()
+    {
+      if (!(middle.load(std::memory_order_relaxed) & FRESH))
+        return false;
+
+      unsigned int previous = middle.exchange(front_index, std::memory_order_acq_rel);
+      front_index = previous & INDEX;
+      return true;
+    }
+
+  private:
+    static constexpr unsigned int INDEX = 3;
+    static constexpr unsigned int FRESH = 4;
+
+    std::array<T, 3> slots;
+
+    unsigned int back_index = 0;
+    std::atomic<unsigned int> middle = 1;
+    unsigned int front_index = 2;
+};
+
+} // namespace str
+
+#endif // str_triple_buffer_hpp
@@ -0,0 +1,252 @@
+#include "src/include/job_system.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace str
+{
+
+// the queue of whichever JobSystem worker runs on this thread; any other thread uses queue 0
+static thread_local const JobSystem * current = nullptr;
+static thread_local unsigned int current_index = 0;
+
+JobSystem::JobSystem(unsigned int threads, bool pin)
+{
+  threads = std::max(threads, 1u);
+
+  queues.reserve(threads);
+  for (unsigned int i = 0; i < threads; ++i)
+    queues.emplace_back(std::make_unique<Queue>());
+
+  workers.reserve(threads - 1);
+  for (unsigned int i = 1; i < threads; ++i)
+    workers.emplace_back(&JobSystem::work, this, i, pin);
+}
+
+JobSystem::~JobSystem()
+{
+  stopping = true;
+  queued.fetch_add(1);
+  queued.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+}
+
+unsigned int JobSystem::threads() const
+{
+  return static_cast<unsigned int>(queues.size());
+}
+
+Job JobSystem::submit(std::function<void()> body, std::initializer_list<Job> dependencies)
+{
+  return submit(std::move(body), std::vector<Job>(dependencies));
+}
+
+Job JobSystem::submit(std::function<void()> body, const std::vector<Job>& dependencies)
+{
+  Job job = std::make_shared<Task>(std::move(body));
+
+  for (const Job& dependency : dependencies)
+  {
+    if (!dependency)
+      continue;
+
+    std::lock_guard<std::mutex> lock(dependency->mutex);
+    if (!dependency->finished())
+    {
+      dependency->dependents.push_back(job);
+      ++job->waiting;
+    }
+  }
+
+  release(job);
+  return job;
+}
+
+// the waiting thread runs queued jobs instead of blocking, so waiting from inside a job never
+// deadlocks; an exception thrown by the job is rethrown here
+void JobSystem::wait(const Job& job)
+{
+  finish(job);
+
+  if (job->error)
+    std::rethrow_exception(job->error);
+}
+
+// every job is finished before the first error is rethrown, since the ones still queued may refer
+// to state the caller releases while unwinding
+void JobSystem::wait(const std::vector<Job>& jobs)
+{
+  for (const Job& job : jobs)
+    finish(job);
+
+  for (const Job& job : jobs)
+  {
+    if (job->error)
+      std::rethrow_exception(job->error);
+  }
+}
+
+// splits [first, last) into chunks of at least grain indices; idle threads steal the chunks the
+// caller has not reached yet
+void JobSystem::parallel_for(unsigned long first, unsigned long last, unsigned long grain,
+                             const std::function<void(unsigned long, unsigned long)>& body)
+{
+  if (first >= last)
+    return;
+
+  grain = std::max(grain, 1ul);
+
+  if (last - first <= grain || threads() == 1)
+  {
+    body(first, last);
+    return;
+  }
+
+  std::vector<Job> chunks;
+  chunks.reserve((last - first + grain - 1) / grain);
+
+  for (unsigned long begin = first; begin < last; begin += grain)
+  {
+    unsigned long end = std::min(begin + grain, last);
+    chunks.emplace_back(submit([&body, begin, end]() { body(begin, end); }));
+  }
+
+  wait(chunks);
+}
+
+void JobSystem::work(unsigned int index, bool pin)
+{
+  current = this;
+  current_index = index;
+
+#ifdef __linux__
+  if (pin)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(index % std::max(std::thread::hardware_concurrency(), 1u), &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }
+#else
+  (void) pin;
+#endif
+
+  while (!stopping)
+  {
+    if (!runOne(index))
+      queued.wait(0);
+  }
+}
+
+void JobSystem::finish(const Job& job)
+{
+  while (!job->finished())
+  {
+    if (!runOne(self()))
+      std::this_thread::yield();
+  }
+}
+
+unsigned int JobSystem::self() const
+{
+  return current == this ? current_index : 0;
+}
+
+void JobSystem::push(Job job)
+{
+  Queue& queue = *queues[self()];
+
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+
+  queued.fetch_add(1);
+  queued.notify_one();
+}
+
+// the owner takes its newest job, which is most likely still in cache
+Job JobSystem::pop(unsigned int index)
+{
+  Queue& queue = *queues[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if (queue.jobs.empty())
+    return nullptr;
+
+  Job job = std::move(queue.jobs.back());
+  queue.jobs.pop_back();
+  queued.fetch_sub(1);
+
+  return job;
+}
+
+// thieves take the oldest job, which tends to be the largest remaining piece of work
+Job JobSystem::steal(unsigned int index)
+{
+  for (unsigned int offset = 1; offset < queues.size(); ++offset)
+  {
+    Queue& queue = *queues[(index + offset) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.jobs.empty())
+      continue;
+
+    Job job = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    queued.fetch_sub(1);
+
+    return job;
+  }
+
+  return nullptr;
+}
+
+bool JobSystem::runOne(unsigned int index)
+{
+  Job job = pop(index);
+  if (!job)
+    job = steal(index);
+
+  if (!job)
+    return false;
+
+  execute(job);
+  return true;
+}
+
+void JobSystem::execute(const Job& job)
+{
+  try
+  {
+    job->body();
+  }
+  catch (...)
+  {
+    job->error = std::current_exception();
+  }
+
+  std::vector<Job> dependents;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->done.store(true, std::memory_order_release);
+    dependents.swap(job->dependents);
+  }
+
+  for (const Job& dependent : dependents)
+    release(dependent);
+}
+
+void JobSystem::release(const Job& job)
+{
+  if (job->waiting.fetch_sub(1) == 1)
+    push(job);
+}
+
+} // namespace str
@@ -0,0 +1,248 @@
+#include "src/include/lensing.hpp"
+#include "src/include/cache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace str
+{
+
+bool LensingTable::empty() const
+{
+  return table.empty();
+}
+
+bool LensingTable::hit() const
+{
+  return loaded;
+}
+
+unsigned int LensingTable::impact() const
+{
+  return built.impact;
+}
+
+unsigned int LensingTable::distance() const
+{
+  return built.distance;
+}
+
+const std::vector<Deflection>& LensingTable::data() const
+{
+  return table;
+}
+
+LensingSSBO LensingTable::header() const
+{
+  return LensingSSBO{
+    .impact   = built.impact,
+    .distance = built.distance,
+    .reach    = built.reach,
+    .padding  = 0.0f
+  };
+}
+
+// reads the table integrated with these tolerances by an earlier launch from the cache directory,
+// or builds and saves it there
+void LensingTable::load(const Tolerances& tolerances, JobSystem& jobs)
+{
+  path = filename(tolerances);
+  LensingHeader header = expected(tolerances);
+  unsigned long count = static_cast<unsigned long>(header.impact) * header.distance;
+
+  LensingHeader stored{};
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char *>(&stored), sizeof(stored));
+
+  loaded = !file.fail() && std::memcmp(&stored, &header, sizeof(header)) == 0;
+
+  if (loaded)
+  {
+    table.resize(count);
+    file.read(reinterpret_cast<char *>(table.data()), count * sizeof(Deflection));
+    loaded = !file.fail();
+  }
+
+  if (loaded)
+  {
+    built = header;
+    return;
+  }
+
+  build(tolerances, jobs);
+
+  // a read-only working directory only costs a rebuild at the next launch
+  try
+  {
+    save();
+  }
+  catch (const std::runtime_error&)
+  {
+  }
+}
+
+// only scenes with a mass to bend around need the table, so a scene without one never builds or
+// reads it and the camera binds a single zero entry in its place
+void LensingTable::load(const TransformStore& transforms, const Tolerances& tolerances, JobSystem& jobs)
+{
+  const auto& masses = transforms.masses();
+  auto massive = [](float mass) { return mass > 0.0f; };
+
+  if (std::any_of(masses.begin(), masses.begin() + transforms.size(), massive))
+    load(tolerances, jobs);
+}
+
+// every entry is an independent geodesic, so rows are integrated in parallel
+void LensingTable::build(const Tolerances& tolerances, JobSystem& jobs)
+{
+  built = expected(tolerances);
+  table.assign(static_cast<unsigned long>(built.impact) * built.distance, Deflection{});
+
+  jobs.parallel_for(0, built.distance, 1, [&](unsigned long first, unsigned long last) {
+    for (unsigned long j = first; j < last; ++j)
+    {
+      float w = STR_LENSING_REACH * j / (built.distance - 1);
+
+      for (unsigned long i = 0; i < built.impact; ++i)
+      {
+        float s = static_cast<float>(i) / built.impact;
+        float u = CRITICAL_IMPACT * (1.0f - (1.0f - s) * (1.0f - s));
+
+        table[j * built.impact + i] = integrate(u, w, tolerances);
+      }
+    }
+  });
+}
+
+// written to a temporary file first so an interrupted save never leaves a truncated table behind
+void LensingTable::save() const
+{
+  if (path.empty() || table.empty())
+    return;
+
+  std::string temporary = path + ".tmp";
+  std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+  if (!file.is_open())
+    throw std::runtime_error("error @ str::LensingTable::save() : could not open " + temporary);
+
+  file.write(reinterpret_cast<const char *>(&built), sizeof(built));
+  file.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(Deflection));
+  file.close();
+
+  if (file.fail() || std::rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("error @ str::LensingTable::save() : could not write " + path);
+  }
+}
+
+// bilinear lookup at u = rs / b and w = rs / r0, the same one trace.glsl does; w beyond the
+// table's reach is clamped, u at or past the photon sphere is the caller's to reject
+Deflection LensingTable::sample(float u, float w) const
+{
+  if (table.empty())
+    return Deflection{};
+
+  float s = 1.0f - std::sqrt(std::max(1.0f - u / CRITICAL_IMPACT, 0.0f));
+  float x = std::clamp(s * built.impact, 0.0f, built.impact - 1.0f);
+  float y = std::clamp(w / built.reach * (built.distance - 1), 0.0f, built.distance - 1.0f);
+
+  unsigned long x0 = static_cast<unsigned long>(x);
+  unsigned long y0 = static_cast<unsigned long>(y);
+  unsigned long x1 = std::min(x0 + 1, static_cast<unsigned long>(built.impact - 1));
+  unsigned long y1 = std::min(y0 + 1, static_cast<unsigned long>(built.distance - 1));
+
+  float fx = x - x0;
+  float fy = y - y0;
+
+  auto at = [this](unsigned long i, unsigned long j) { return table[j * built.impact + i]; };
+  auto mix = [](const Deflection& a, const Deflection& b, float f) {
+    return Deflection{ a.angle + (b.angle - a.angle) * f, a.delay + (b.delay - a.delay) * f };
+  };
+
+  return mix(mix(at(x0, y0), at(x1, y0), fx), mix(at(x0, y1), at(x1, y1), fx), fy);
+}
+
+std::string LensingTable::filename(const Tolerances& tolerances) const
+{
+  std::ostringstream name;
+  name << STR_LENSING_PREFIX << std::hex
+       << std::bit_cast<unsigned int>(tolerances.relative) << "_"
+       << std::bit_cast<unsigned int>(tolerances.absolute) << "_"
+       << tolerances.steps << "_" << STR_LENSING_VERSION << ".lut";
+
+  return cachePath(name.str());
+}
+
+LensingHeader LensingTable::expected(const Tolerances& tolerances) const
+{
+  return LensingHeader{
+    .magic    = { 'S', 'T', 'R', 'L' },
+    .version  = STR_LENSING_VERSION,
+    .impact   = STR_LENSING_IMPACT,
+    .distance = STR_LENSING_DISTANCE,
+    .relative = tolerances.relative,
+    .absolute = tolerances.absolute,
+    .steps    = tolerances.steps,
+    .reach    = STR_LENSING_REACH
+  };
+}
+
+// integrates a ray past a mass of rs = 1 from r0 = 1 / w (or STR_LENSING_FAR for w = 0) with
+// impact parameter b = 1 / u, summing how far its direction turns and how much longer it takes
+// than in flat space
+Deflection LensingTable::integrate(float u, float w, const Tolerances& tolerances) const
+{
+  if (u <= 0.0f)
+    return Deflection{};
+
+  std::vector<Lens> lens = { Lens{ .position = { 0.0f, 0.0f, 0.0f }, .mass = 0.5f } };
+
+  float b = 1.0f / u;
+  float r0 = std::max(w > 0.0f ? 1.0f / w : STR_LENSING_FAR, b);
+
+  Photon photon{ { -std::sqrt(r0 * r0 - b * b), b, 0.0f }, { 1.0f, 0.0f, 0.0f } };
+  la::vec<3> k1 = bend(photon.x, photon.v, lens);
+
+  Deflection result;
+  float h = 0.1f * r0;
+
+  for (unsigned int i = 0; i < tolerances.steps; ++i)
+  {
+    float r = photon.x.norm();
+    h = std::min(h, 0.5f * r);
+
+    Photon next;
+    la::vec<3> k7;
+    float error = dormandPrince(photon, k1, h, lens, next, k7, tolerances);
+    float scale = std::clamp(0.9f * std::pow(std::max(error, 1e-10f), -0.2f), 0.2f, 5.0f);
+
+    h *= scale;
+    if (error > 1.0f)
+      continue;
+
+    la::vec<3> turn = photon.v % next.v;
+    result.angle -= std::atan2(turn[2], photon.v * next.v);
+
+    float length = (next.x - photon.x).norm();
+    float middle = (0.5f * (next.x + photon.x)).norm();
+    result.delay += length * (1.0f / (1.0f - 1.0f / middle) - 1.0f);
+
+    photon = next;
+    k1 = k7;
+
+    if (captured(photon.x, lens) || (photon.x * photon.v > 0.0f && photon.x.norm() > STR_LENSING_FAR))
+      break;
+  }
+
+  return result;
+}
+
+} // namespace str
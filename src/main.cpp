@@ -1,11 +1,150 @@
 #include "src/include/engine.hpp"
+#include "src/include/headless.hpp"
+#include "src/include/scene.hpp"
+#include "src/include/tracer.hpp"
 
-int main()
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static str::Framebuffer trace(unsigned int threads, str::TraceStats& stats)
+{
+  str::Camera camera;
+
+  str::TransformStore transforms;
+  unsigned long e_id = 1;
+  for (const auto& object : str::defaultScene())
+    transforms.insert(e_id++, object);
+
+  str::BVH bvh;
+  bvh.build(transforms);
+
+  str::Framebuffer framebuffer;
+  framebuffer.resize(VECS_SETTINGS.extent().width, VECS_SETTINGS.extent().height);
+
+  str::JobSystem jobs(threads);
+  str::Tracer tracer(jobs);
+
+  // the same lookups the shaders bend rays with, so the two stay comparable
+  str::LensingTable lensing;
+  lensing.load(transforms, camera.geodesicTolerances(), jobs);
+  tracer.setLensing(&lensing);
+  stats = tracer.render(framebuffer, camera.view_matrix(), camera.near_plane_dimensions(), transforms, bvh);
+
+  return framebuffer;
+}
+
+static int reference(const std::string& path, unsigned int threads)
 {
+  str::TraceStats stats;
+  str::Framebuffer framebuffer = trace(threads, stats);
+
+  framebuffer.write(path);
+
+  std::cout << "reference: " << framebuffer.width << "x" << framebuffer.height << " in " << stats.seconds * 1000 << "ms on "
+            << stats.threads << " threads (" << stats.raysPerSecond() / 1e6 << " Mrays/s, "
+            << stats.raysPerSecondPerCore() / 1e6 << " Mrays/s/core)\n";
+
+  return 0;
+}
+
+// renders the converged GPU image and the CPU reference of the same scene and fails when they
+// differ by more than the tolerance. the reference is clamped to the range the 8 bit target can
+// hold, and traces one ray per pixel centre where the GPU averages jittered samples, so the
+// tolerance has room for antialiased edges
+static int compare(str::Backend backend, float tolerance, unsigned int threads, bool pin)
+{
+  str::Headless renderer(backend, threads, pin);
+
+  renderer.load();
+  renderer.run(0);
+
+  str::TraceStats stats;
+  str::Framebuffer expected = trace(threads, stats);
+
+  for (auto& pixel : expected.pixels)
+  {
+    for (unsigned long i = 0; i < 3; ++i)
+      pixel[i] = std::clamp(pixel[i], 0.0f, 1.0f);
+  }
+
+  float error = renderer.result().rmse(expected);
+  bool match = error <= tolerance;
+
+  std::cout << "compare: rmse " << error << " against a tolerance of " << tolerance << (match ? ", match\n" : ", MISMATCH\n");
+
+  return match ? 0 : 1;
+}
+
+// a frame count of 0 renders until the image stops changing
+static int headless(unsigned long frames, const std::string& path, str::Backend backend, const std::string& profile,
+                    unsigned int threads, bool pin)
+{
+  str::Headless renderer(backend, threads, pin);
+
+  renderer.load();
+  renderer.run(frames);
+
+  if (!path.empty())
+    renderer.result().write(path);
+
+  if (!profile.empty())
+    renderer.profile().write(profile);
+
+  return 0;
+}
+
+int main(int argc, char ** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+
+  str::Backend backend = str::Backend::Graphics;
+  if (auto it = std::find(args.begin(), args.end(), "--compute"); it != args.end())
+  {
+    backend = str::Backend::Compute;
+    args.erase(it);
+  }
+
+  // phase percentiles as .json, or csv for any other extension
+  std::string profile;
+  if (auto it = std::find(args.begin(), args.end(), "--profile"); it != args.end() && it + 1 != args.end())
+  {
+    profile = *(it + 1);
+    args.erase(it, it + 2);
+  }
+
+  // job system threads, counting the main thread, optionally pinned one per core
+  unsigned int threads = std::thread::hardware_concurrency();
+  if (auto it = std::find(args.begin(), args.end(), "--threads"); it != args.end() && it + 1 != args.end())
+  {
+    threads = std::stoul(*(it + 1));
+    args.erase(it, it + 2);
+  }
+
+  bool pin = false;
+  if (auto it = std::find(args.begin(), args.end(), "--pin"); it != args.end())
+  {
+    pin = true;
+    args.erase(it);
+  }
+
+  if (args.size() > 1 && args[0] == "--reference")
+    return reference(args[1], args.size() > 2 ? std::stoul(args[2]) : threads);
+
+  if (args.size() > 0 && args[0] == "--compare")
+    return compare(backend, args.size() > 1 ? std::stof(args[1]) : STR_REFERENCE_RMSE, threads, pin);
+
+  if (args.size() > 0 && args[0] == "--headless")
+    return headless(args.size() > 1 ? std::stoul(args[1]) : 0, args.size() > 2 ? args[2] : "", backend, profile, threads, pin);
+
   VECS_SETTINGS.add_device_extension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
 
-  str::Engine engine;
+  str::Engine engine(backend, threads, pin);
 
   engine.load();
   engine.run();
-}
\ No newline at end of file
+
+  if (!profile.empty())
+    engine.profile().write(profile);
+}
@@ -0,0 +1,226 @@
+#include "src/include/offscreen.hpp"
+#include "src/include/buffer.hpp"
+
+#include <cmath>
+
+namespace str
+{
+
+const vk::Extent2D& Offscreen::extent() const
+{
+  return dimensions;
+}
+
+vk::Image Offscreen::image() const
+{
+  return *vk_color;
+}
+
+const vk::raii::ImageView& Offscreen::imageView() const
+{
+  return vk_colorView;
+}
+
+const vk::raii::ImageView& Offscreen::depthView() const
+{
+  return vk_depthView;
+}
+
+void Offscreen::load(const Device& device, vk::Extent2D extent)
+{
+  dimensions = extent;
+
+  createImage(
+    device,
+    VECS_SETTINGS.format(),
+    vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst,
+    vk::ImageAspectFlagBits::eColor,
+    vk_color,
+    vk_colorMemory,
+    vk_colorView
+  );
+
+  createImage(
+    device,
+    VECS_SETTINGS.depth_format(),
+    vk::ImageUsageFlagBits::eDepthStencilAttachment,
+    vk::ImageAspectFlagBits::eDepth,
+    vk_depth,
+    vk_depthMemory,
+    vk_depthView
+  );
+
+  // the renderer clears depth every frame but expects it in attachment layout, as the swapchain
+  // depth image is
+  submitImmediate(device, [&](const vk::raii::CommandBuffer& vk_commandBuffer){
+    vk::ImageMemoryBarrier memoryBarrier{
+      .dstAccessMask    = vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+      .oldLayout        = vk::ImageLayout::eUndefined,
+      .newLayout        = vk::ImageLayout::eDepthAttachmentOptimal,
+      .image            = *vk_depth,
+      .subresourceRange = {
+        .aspectMask       = vk::ImageAspectFlagBits::eDepth,
+        .baseMipLevel     = 0,
+        .levelCount       = 1,
+        .baseArrayLayer   = 0,
+        .layerCount       = 1
+      }
+    };
+
+    vk_commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTopOfPipe,
+      vk::PipelineStageFlagBits::eEarlyFragmentTests,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      memoryBarrier
+    );
+  });
+
+  vk::DeviceSize size = static_cast<vk::DeviceSize>(extent.width) * extent.height * 4;
+
+  vk_readbacks.clear();
+  vk_readbackMemories.clear();
+  mapped.clear();
+
+  for (unsigned long i = 0; i < VECS_SETTINGS.max_flight_frames(); ++i)
+  {
+    vk::raii::Buffer vk_buffer = nullptr;
+    vk::raii::DeviceMemory vk_memory = nullptr;
+
+    createBuffer(
+      device,
+      size,
+      vk::BufferUsageFlagBits::eTransferDst,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+      vk_buffer,
+      vk_memory
+    );
+
+    mapped.emplace_back(vk_memory.mapMemory(0, size));
+    vk_readbacks.emplace_back(std::move(vk_buffer));
+    vk_readbackMemories.emplace_back(std::move(vk_memory));
+  }
+}
+
+void Offscreen::recordReadback(const vk::raii::CommandBuffer& vk_commandBuffer, unsigned int frame) const
+{
+  vk::BufferImageCopy region{
+    .bufferOffset       = 0,
+    .bufferRowLength    = 0,
+    .bufferImageHeight  = 0,
+    .imageSubresource   = {
+      .aspectMask       = vk::ImageAspectFlagBits::eColor,
+      .mipLevel         = 0,
+      .baseArrayLayer   = 0,
+      .layerCount       = 1
+    },
+    .imageOffset        = { 0, 0, 0 },
+    .imageExtent        = { dimensions.width, dimensions.height, 1 }
+  };
+
+  vk_commandBuffer.copyImageToBuffer(*vk_color, vk::ImageLayout::eTransferSrcOptimal, *vk_readbacks[frame], region);
+
+  vk::BufferMemoryBarrier memoryBarrier{
+    .srcAccessMask        = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask        = vk::AccessFlagBits::eHostRead,
+    .srcQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .dstQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .buffer               = *vk_readbacks[frame],
+    .offset               = 0,
+    .size                 = vk::WholeSize
+  };
+
+  vk_commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eHost,
+    vk::DependencyFlags(),
+    nullptr,
+    memoryBarrier,
+    nullptr
+  );
+}
+
+void Offscreen::read(unsigned int frame, Framebuffer& framebuffer) const
+{
+  vk::Format format = VECS_SETTINGS.format();
+
+  bool bgra = format == vk::Format::eB8G8R8A8Unorm || format == vk::Format::eB8G8R8A8Srgb;
+  bool srgb = format == vk::Format::eB8G8R8A8Srgb || format == vk::Format::eR8G8B8A8Srgb;
+
+  if (!bgra && format != vk::Format::eR8G8B8A8Unorm && format != vk::Format::eR8G8B8A8Srgb)
+    throw std::runtime_error("error @ str::Offscreen::read() : unsupported color format " + vk::to_string(format));
+
+  // back to the linear values the shader wrote, so the result compares against the CPU tracer
+  auto decode = [srgb](unsigned char byte) {
+    float c = byte / 255.0f;
+    if (!srgb) return c;
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+  };
+
+  framebuffer.resize(dimensions.width, dimensions.height);
+
+  const unsigned char * texels = static_cast<const unsigned char *>(mapped[frame]);
+  for (unsigned long i = 0; i < framebuffer.pixels.size(); ++i)
+  {
+    const unsigned char * texel = texels + 4 * i;
+
+    framebuffer.pixels[i] = {
+      decode(texel[bgra ? 2 : 0]),
+      decode(texel[1]),
+      decode(texel[bgra ? 0 : 2])
+    };
+  }
+}
+
+void Offscreen::createImage(
+  const Device& device,
+  vk::Format format,
+  vk::ImageUsageFlags usage,
+  vk::ImageAspectFlags aspect,
+  vk::raii::Image& vk_image,
+  vk::raii::DeviceMemory& vk_memory,
+  vk::raii::ImageView& vk_view
+) const
+{
+  vk::ImageCreateInfo ci_image{
+    .imageType      = vk::ImageType::e2D,
+    .format         = format,
+    .extent         = { dimensions.width, dimensions.height, 1 },
+    .mipLevels      = 1,
+    .arrayLayers    = 1,
+    .samples        = vk::SampleCountFlagBits::e1,
+    .tiling         = vk::ImageTiling::eOptimal,
+    .usage          = usage,
+    .sharingMode    = vk::SharingMode::eExclusive,
+    .initialLayout  = vk::ImageLayout::eUndefined
+  };
+
+  vk_image = device.logical().createImage(ci_image);
+  auto requirements = vk_image.getMemoryRequirements();
+
+  vk::MemoryAllocateInfo ai_memory{
+    .allocationSize   = requirements.size,
+    .memoryTypeIndex  = findMemoryIndex(device.physical(), requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal)
+  };
+
+  vk_memory = device.logical().allocateMemory(ai_memory);
+  vk_image.bindMemory(*vk_memory, 0);
+
+  vk::ImageViewCreateInfo ci_view{
+    .image            = *vk_image,
+    .viewType         = vk::ImageViewType::e2D,
+    .format           = format,
+    .subresourceRange = {
+      .aspectMask       = aspect,
+      .baseMipLevel     = 0,
+      .levelCount       = 1,
+      .baseArrayLayer   = 0,
+      .layerCount       = 1
+    }
+  };
+
+  vk_view = device.logical().createImageView(ci_view);
+}
+
+} // namespace str
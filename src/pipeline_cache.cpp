@@ -0,0 +1,124 @@
+#include "src/include/pipeline_cache.hpp"
+#include "src/include/cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace str
+{
+
+const vk::raii::PipelineCache& PipelineCache::cache() const
+{
+  return vk_cache;
+}
+
+bool PipelineCache::hit() const
+{
+  return loaded;
+}
+
+void PipelineCache::load(const Device& device)
+{
+  auto properties = device.physical().getProperties();
+  path = filename(properties);
+
+  std::vector<char> data;
+
+  std::ifstream file(path, std::ios::ate | std::ios::binary);
+  if (!file.fail())
+  {
+    data.resize(file.tellg());
+    file.seekg(0);
+    file.read(data.data(), data.size());
+  }
+
+  loaded = valid(data, properties);
+
+  if (loaded)
+  {
+    vk::PipelineCacheCreateInfo ci_cache{
+      .initialDataSize  = data.size(),
+      .pInitialData     = data.data()
+    };
+
+    // the header only vouches for the device, so a corrupt body can still be refused
+    try
+    {
+      vk_cache = device.logical().createPipelineCache(ci_cache);
+      return;
+    }
+    catch (const vk::SystemError&)
+    {
+      loaded = false;
+    }
+  }
+
+  vk_cache = device.logical().createPipelineCache(vk::PipelineCacheCreateInfo{});
+}
+
+// written to a temporary file first so an interrupted save never leaves a truncated cache behind
+void PipelineCache::save() const
+{
+  if (path.empty() || !*vk_cache)
+    return;
+
+  auto data = vk_cache.getData();
+
+  std::string temporary = path + ".tmp";
+  std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+  if (!file.is_open())
+    throw std::runtime_error("error @ str::PipelineCache::save() : could not open " + temporary);
+
+  file.write(reinterpret_cast<const char *>(data.data()), data.size());
+  file.close();
+
+  if (file.fail() || std::rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("error @ str::PipelineCache::save() : could not write " + path);
+  }
+}
+
+void PipelineCache::record(float milliseconds)
+{
+  creation_ms = milliseconds;
+}
+
+void PipelineCache::report(std::ostream& out) const
+{
+  out << "pipelines: " << creation_ms << "ms (" << (loaded ? "cache hit" : "cache miss") << ", " << path << ")\n";
+}
+
+std::string PipelineCache::filename(const vk::PhysicalDeviceProperties& properties) const
+{
+  std::ostringstream name;
+  name << STR_PIPELINE_CACHE_PREFIX << std::hex << std::setfill('0');
+
+  for (unsigned char byte : properties.pipelineCacheUUID)
+    name << std::setw(2) << static_cast<unsigned int>(byte);
+
+  name << "_" << std::setw(8) << properties.driverVersion << ".cache";
+  return cachePath(name.str());
+}
+
+bool PipelineCache::valid(const std::vector<char>& data, const vk::PhysicalDeviceProperties& properties) const
+{
+  if (data.size() < sizeof(PipelineCacheHeader))
+    return false;
+
+  PipelineCacheHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  return header.size >= sizeof(PipelineCacheHeader) &&
+         header.size <= data.size() &&
+         header.version == static_cast<unsigned int>(vk::PipelineCacheHeaderVersion::eOne) &&
+         header.vendor == properties.vendorID &&
+         header.device == properties.deviceID &&
+         std::memcmp(header.uuid, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+}
+
+} // namespace str
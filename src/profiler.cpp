@@ -0,0 +1,153 @@
+#include "src/include/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace str
+{
+
+const char * phaseName(Phase phase)
+{
+  switch (phase)
+  {
+    case Phase::Acquire:    return "acquire";
+    case Phase::Upload:     return "upload";
+    case Phase::Record:     return "record";
+    case Phase::Submit:     return "submit";
+    case Phase::Present:    return "present";
+    case Phase::FenceWait:  return "fence_wait";
+    case Phase::Gpu:        return "gpu";
+    case Phase::Frame:      return "frame";
+    case Phase::Steps:      return "steps_per_ray";
+    default:                return "unknown";
+  }
+}
+
+RollingWindow::RollingWindow(unsigned long capacity) : samples(std::max(capacity, 1ul))
+{
+}
+
+void RollingWindow::push(float sample)
+{
+  samples[next] = sample;
+  next = (next + 1) % samples.size();
+  filled = std::min(filled + 1, samples.size());
+}
+
+void RollingWindow::clear()
+{
+  next = 0;
+  filled = 0;
+}
+
+Percentiles RollingWindow::percentiles() const
+{
+  if (filled == 0)
+    return Percentiles{};
+
+  std::vector<float> sorted(samples.begin(), samples.begin() + filled);
+  std::sort(sorted.begin(), sorted.end());
+
+  // nearest rank
+  auto rank = [&sorted](float p) {
+    unsigned long index = static_cast<unsigned long>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp(index, 1ul, sorted.size()) - 1];
+  };
+
+  return Percentiles{
+    .count  = filled,
+    .p50    = rank(0.50f),
+    .p95    = rank(0.95f),
+    .p99    = rank(0.99f),
+    .max    = sorted.back()
+  };
+}
+
+Profiler::Scope::Scope(Profiler& p, Phase ph) : profiler(p), phase(ph), start(std::chrono::steady_clock::now())
+{
+}
+
+Profiler::Scope::~Scope()
+{
+  auto end = std::chrono::steady_clock::now();
+  profiler.record(phase, std::chrono::duration<float, std::milli>(end - start).count());
+}
+
+Profiler::Scope Profiler::scope(Phase phase)
+{
+  return Scope(*this, phase);
+}
+
+void Profiler::record(Phase phase, float milliseconds)
+{
+  windows[static_cast<unsigned long>(phase)].push(milliseconds);
+}
+
+Percentiles Profiler::percentiles(Phase phase) const
+{
+  return windows[static_cast<unsigned long>(phase)].percentiles();
+}
+
+void Profiler::report(std::ostream& out) const
+{
+  out << std::fixed << std::setprecision(3);
+  out << std::left << std::setw(12) << "phase" << std::right
+      << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms" << std::setw(10) << "p99 ms" << std::setw(10) << "max ms" << "\n";
+
+  for (unsigned int i = 0; i < windows.size(); ++i)
+  {
+    Percentiles p = windows[i].percentiles();
+    if (p.count == 0) continue;
+
+    out << std::left << std::setw(12) << phaseName(static_cast<Phase>(i)) << std::right
+        << std::setw(10) << p.p50 << std::setw(10) << p.p95 << std::setw(10) << p.p99 << std::setw(10) << p.max << "\n";
+  }
+
+  out << std::defaultfloat;
+}
+
+void Profiler::writeCSV(std::ostream& out) const
+{
+  out << "phase,count,p50_ms,p95_ms,p99_ms,max_ms\n";
+
+  for (unsigned int i = 0; i < windows.size(); ++i)
+  {
+    Percentiles p = windows[i].percentiles();
+    out << phaseName(static_cast<Phase>(i)) << "," << p.count << "," << p.p50 << "," << p.p95 << "," << p.p99 << "," << p.max << "\n";
+  }
+}
+
+void Profiler::writeJSON(std::ostream& out) const
+{
+  out << "{\n";
+
+  for (unsigned int i = 0; i < windows.size(); ++i)
+  {
+    Percentiles p = windows[i].percentiles();
+    out << "  \"" << phaseName(static_cast<Phase>(i)) << "\": { \"count\": " << p.count
+        << ", \"p50_ms\": " << p.p50 << ", \"p95_ms\": " << p.p95
+        << ", \"p99_ms\": " << p.p99 << ", \"max_ms\": " << p.max << " }"
+        << (i + 1 < windows.size() ? ",\n" : "\n");
+  }
+
+  out << "}\n";
+}
+
+// JSON for a .json path, CSV otherwise
+void Profiler::write(const std::string& path) const
+{
+  std::ofstream file(path);
+
+  if (!file.is_open())
+    throw std::runtime_error("error @ str::Profiler::write() : could not open " + path);
+
+  if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+    writeJSON(file);
+  else
+    writeCSV(file);
+}
+
+} // namespace str
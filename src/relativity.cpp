@@ -0,0 +1,97 @@
+#include "src/include/relativity.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace str
+{
+
+// wavelengths in nm the red, green and blue channels are taken to sample an object's spectrum at
+static constexpr float RED = 610.0f;
+static constexpr float GREEN = 550.0f;
+static constexpr float BLUE = 465.0f;
+static constexpr float VISIBLE_LO = 380.0f;
+static constexpr float VISIBLE_HI = 700.0f;
+
+// speeds are clamped just below c, where the Lorentz factor is still finite
+Boost boost(const la::vec<3>& velocity)
+{
+  la::vec<3> beta = velocity;
+  float speed = beta.norm();
+
+  if (speed > STR_MAX_SPEED)
+    beta = (STR_MAX_SPEED / speed) * beta;
+
+  float b2 = beta * beta;
+  if (b2 == 0.0f)
+    return Boost{};
+
+  float gamma = 1.0f / std::sqrt(1.0f - b2);
+
+  // x' = x + (gamma - 1) (x . b^) b^ - gamma b t, t' = gamma (t - b . x); gamma^2 / (gamma + 1)
+  // is (gamma - 1) / b^2 without cancelling at low speeds
+  float k = gamma * gamma / (gamma + 1.0f);
+
+  Boost result;
+  for (unsigned long j = 0; j < 3; ++j)
+  {
+    la::vec<3> column = k * beta[j] * beta;
+    column[j] += 1.0f;
+
+    result.matrix[j] = la::vec<4>(column, { -gamma * beta[j] });
+  }
+
+  result.matrix[3] = la::vec<4>(-gamma * beta, { gamma });
+  result.motion = la::vec<4>(beta, { gamma });
+
+  return result;
+}
+
+void computeBoosts(const TransformStore& transforms, Boost * out, unsigned long first, unsigned long last)
+{
+  const auto& velocities = transforms.velocities();
+
+  for (unsigned long i = first; i < last; ++i)
+    out[i] = boost(velocities[i]);
+}
+
+// every slot is independent, so chunks of the range are boosted in parallel
+void computeBoosts(const TransformStore& transforms, Boost * out, unsigned long first, unsigned long last, JobSystem& jobs)
+{
+  jobs.parallel_for(first, last, STR_JOB_GRAIN, [&transforms, out](unsigned long begin, unsigned long end) {
+    computeBoosts(transforms, out, begin, end);
+  });
+}
+
+// frequency seen over frequency emitted, for a ray leaving the camera along dir: above 1 when the
+// object moves towards the camera
+float doppler(const Boost& b, const la::vec<3>& dir)
+{
+  la::vec<3> beta = { b.motion[0], b.motion[1], b.motion[2] };
+  return 1.0f / (b.motion[3] * (1.0f + beta * dir));
+}
+
+// reads each channel from the wavelength it was emitted at, on a spectrum running linearly
+// through the three channels and to nothing at the edges of the visible range, and brightens it
+// by the D^3 of relativistic beaming
+la::vec<3> shift(const la::vec<3>& color, float d)
+{
+  auto spectrum = [&color](float lambda) {
+    float xs[5] = { VISIBLE_LO, BLUE, GREEN, RED, VISIBLE_HI };
+    float ys[5] = { 0.0f, color[2], color[1], color[0], 0.0f };
+
+    if (lambda <= xs[0] || lambda >= xs[4])
+      return 0.0f;
+
+    unsigned long i = 1;
+    while (lambda > xs[i])
+      ++i;
+
+    return ys[i - 1] + (ys[i] - ys[i - 1]) * (lambda - xs[i - 1]) / (xs[i] - xs[i - 1]);
+  };
+
+  float beaming = d * d * d;
+  return beaming * la::vec<3>{ spectrum(RED * d), spectrum(GREEN * d), spectrum(BLUE * d) };
+}
+
+} // namespace str
@@ -2,6 +2,7 @@
 #include "src/include/camera.hpp"
 #include "src/include/transform.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 
@@ -10,71 +11,148 @@ namespace str
 
 void Renderer::update(
   const std::shared_ptr<vecs::ComponentManager>& component_manager,
-  std::set<unsigned long> e_ids
+  const std::set<unsigned long>& e_ids
 )
 {
-  auto result = vecs_gui->swapchain().acquireNextImage(UINT64_MAX, *imageSemaphores[frame], nullptr);
-  checkResult(result.first, "retrieve");
-
-  vecs_device->logical().resetFences(*flightFences[frame]);
-
-  if (e_ids.empty()) return;
+  // the scene arrives through setTransforms(), so the only entity drawn from is the camera
+  if (!e_ids.contains(camera_id)) return;
 
   auto camera_opt = component_manager->retrieve<p_camera>(camera_id);
   if (camera_opt == std::nullopt) return;
-  auto camera = camera_opt.value();
 
+  draw(*camera_opt.value());
+}
+
+void Renderer::draw(Camera& camera)
+{
+  unsigned int imageIndex = 0;
 
-  std::vector<Transform> transforms;
-  unsigned long index = 0;
-  for (const auto& e_id : e_ids)
+  if (!offscreen)
   {
-    auto transform = component_manager->retrieve<Transform>(e_id);
-    if (transform == std::nullopt) continue;
+    auto scope = profiler->scope(Phase::Acquire);
 
-    transforms.emplace_back(transform.value());
-    if (++index == STR_MAX_TRANSFORMS) break;
+    auto result = vecs_gui->swapchain().acquireNextImage(UINT64_MAX, *imageSemaphores[frame], nullptr);
+    checkResult(result.first, "retrieve");
+    imageIndex = result.second;
   }
 
-  camera->updateSSBO(frame, transforms);
+  device->logical().resetFences(*flightFences[frame]);
 
-  begin(result.second);
+  // integration steps per ray, in place of milliseconds, while there are masses to bend around
+  if (auto steps = camera.stepsPerRay(frame))
+    profiler->record(Phase::Steps, *steps);
 
-  for (const auto& e_id : e_ids)
-    render(component_manager, result.second);
+  if (transforms->revision() != revision)
+  {
+    camera.resetSamples();
+    revision = transforms->revision();
+  }
+
+  SlotRange changed = transforms->takeChanges();
+  for (auto& range : pending)
+    range.merge(changed);
+
+  {
+    auto scope = profiler->scope(Phase::Upload);
 
-  end(result.second);
+    // each frame slot catches up on whatever changed since it was last uploaded, and a slot
+    // that has never been uploaded takes everything
+    if (ssboUploads[frame] != revision)
+    {
+      SlotRange range = ssboUploads[frame] ? pending[frame] : SlotRange{ 0, transforms->size() };
+      unsigned long last = std::min(range.last, transforms->size());
+
+      camera.updateSSBO(*device, frame, *transforms, std::min(range.first, last), last, *jobs);
+
+      ssboUploads[frame] = revision;
+      pending[frame] = SlotRange{};
+    }
+
+    if (built != revision)
+    {
+      bvh.update(*transforms, *jobs);
+      built = revision;
+    }
+
+    if (bvhUploads[frame] != revision)
+    {
+      camera.updateBVH(*device, frame, bvh);
+      bvhUploads[frame] = revision;
+    }
+
+    camera.updateFrame(frame);
+    camera.updateSpacetime(frame, *transforms);
+  }
 
-  vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+  unsigned long trace = frame * targets + imageIndex;
+
+  {
+    auto scope = profiler->scope(Phase::Record);
+
+    recordFrame(camera);
+
+    // uploads above may have rewritten this frame's descriptor set, which also bumps the revision
+    if (recordings[trace] != camera.revision())
+    {
+      recordTrace(camera, imageIndex, vk_traceBuffers[trace]);
+      recordings[trace] = camera.revision();
+    }
+  }
+
+  std::array<vk::CommandBuffer, 2> commandBuffers = { *vk_commandBuffers[frame], *vk_traceBuffers[trace] };
+
+  // the compute backend first touches the swapchain image with its blit
+  vk::PipelineStageFlags waitStage = backend == Backend::Graphics
+    ? vk::PipelineStageFlagBits::eColorAttachmentOutput
+    : vk::PipelineStageFlagBits::eTransfer;
   vk::SubmitInfo submitInfo{
-    .waitSemaphoreCount   = 1,
+    .waitSemaphoreCount   = offscreen ? 0u : 1u,
     .pWaitSemaphores      = &*imageSemaphores[frame],
     .pWaitDstStageMask    = &waitStage,
-    .commandBufferCount   = 1,
-    .pCommandBuffers      = &*vk_commandBuffers[frame],
-    .signalSemaphoreCount = 1,
+    .commandBufferCount   = static_cast<unsigned int>(commandBuffers.size()),
+    .pCommandBuffers      = commandBuffers.data(),
+    .signalSemaphoreCount = offscreen ? 0u : 1u,
     .pSignalSemaphores    = &*renderSemaphores[frame]
   };
 
-  vecs_device->queue(vecs::FamilyType::All).submit(submitInfo, *flightFences[frame]);
+  {
+    auto scope = profiler->scope(Phase::Submit);
+    device->queue().submit(submitInfo, *flightFences[frame]);
+  }
 
-  vk::PresentInfoKHR presentInfo{
-    .waitSemaphoreCount = 1,
-    .pWaitSemaphores    = &*renderSemaphores[frame],
-    .swapchainCount     = 1,
-    .pSwapchains        = &*vecs_gui->swapchain(),
-    .pImageIndices      = &result.second
-  };
+  if (!offscreen)
+  {
+    auto scope = profiler->scope(Phase::Present);
+
+    vk::PresentInfoKHR presentInfo{
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores    = &*renderSemaphores[frame],
+      .swapchainCount     = 1,
+      .pSwapchains        = &*vecs_gui->swapchain(),
+      .pImageIndices      = &imageIndex
+    };
 
-  auto presentResult = vecs_device->queue(vecs::FamilyType::All).presentKHR(presentInfo);
-  checkResult(presentResult, "present");
+    auto presentResult = device->queue().presentKHR(presentInfo);
+    checkResult(presentResult, "present");
+  }
 
   frame = ++frame % VECS_SETTINGS.max_flight_frames();
 }
 
-void Renderer::waitFlight() const
+// nothing moved since the camera reached its sample budget, so another frame would not change the image
+bool Renderer::converged(const Camera& camera) const
 {
-  static_cast<void>(vecs_device->logical().waitForFences(*flightFences[frame], vk::True, UINT64_MAX));
+  return camera.converged() && transforms->revision() == revision;
+}
+
+void Renderer::waitFlight()
+{
+  {
+    auto scope = profiler->scope(Phase::FenceWait);
+    static_cast<void>(device->logical().waitForFences(*flightFences[frame], vk::True, UINT64_MAX));
+  }
+
+  readTimestamps();
 }
 
 const unsigned int& Renderer::currentFrame() const
@@ -82,26 +160,38 @@ const unsigned int& Renderer::currentFrame() const
   return frame;
 }
 
-void Renderer::link(std::shared_ptr<vecs::Device> p_device, std::shared_ptr<vecs::GUI> p_gui)
+void Renderer::link(std::shared_ptr<Device> p_device, std::shared_ptr<vecs::Device> p_vecs_device, std::shared_ptr<vecs::GUI> p_gui)
 {
-  vecs_device = p_device;
+  device = p_device;
+  vecs_device = p_vecs_device;
   vecs_gui = p_gui;
+  offscreen.reset();
+}
+
+void Renderer::link(std::shared_ptr<Device> p_device, std::shared_ptr<Offscreen> p_offscreen)
+{
+  device = p_device;
+  offscreen = p_offscreen;
+  vecs_device.reset();
+  vecs_gui.reset();
 }
 
 void Renderer::initialize()
 {
   vk::CommandPoolCreateInfo ci_commandPool{
     .flags  = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-    .queueFamilyIndex = static_cast<unsigned int>(vecs_device->familyIndex(vecs::FamilyType::All))
+    .queueFamilyIndex = device->familyIndex()
   };
-  vk_commandPool = vecs_device->logical().createCommandPool(ci_commandPool);
+  vk_commandPool = device->logical().createCommandPool(ci_commandPool);
 
   vk::CommandBufferAllocateInfo ai_commandBuffers{
     .commandPool        = *vk_commandPool,
     .level              = vk::CommandBufferLevel::ePrimary,
     .commandBufferCount = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames())
   };
-  vk_commandBuffers = vk::raii::CommandBuffers(vecs_device->logical(), ai_commandBuffers);
+  vk_commandBuffers = vk::raii::CommandBuffers(device->logical(), ai_commandBuffers);
+
+  invalidate();
 
   for (unsigned long i = 0; i < VECS_SETTINGS.max_flight_frames(); ++i)
   {
@@ -110,9 +200,32 @@ void Renderer::initialize()
     };
     vk::SemaphoreCreateInfo ci_semaphore{};
 
-    flightFences.emplace_back(vecs_device->logical().createFence(ci_fence));
-    imageSemaphores.emplace_back(vecs_device->logical().createSemaphore(ci_semaphore));
-    renderSemaphores.emplace_back(vecs_device->logical().createSemaphore(ci_semaphore));
+    flightFences.emplace_back(device->logical().createFence(ci_fence));
+    imageSemaphores.emplace_back(device->logical().createSemaphore(ci_semaphore));
+    renderSemaphores.emplace_back(device->logical().createSemaphore(ci_semaphore));
+  }
+
+  pending.assign(VECS_SETTINGS.max_flight_frames(), SlotRange{});
+  ssboUploads.assign(VECS_SETTINGS.max_flight_frames(), std::nullopt);
+  bvhUploads.assign(VECS_SETTINGS.max_flight_frames(), std::nullopt);
+  built.reset();
+
+  // GPU timings are skipped on queues without timestamp support
+  auto families = device->physical().getQueueFamilyProperties();
+  if (families[device->familyIndex()].timestampValidBits == 0)
+    return;
+
+  timestampPeriod = device->physical().getProperties().limits.timestampPeriod;
+  timed.assign(VECS_SETTINGS.max_flight_frames(), false);
+
+  for (unsigned long i = 0; i < VECS_SETTINGS.max_flight_frames(); ++i)
+  {
+    vk::QueryPoolCreateInfo ci_queryPool{
+      .queryType  = vk::QueryType::eTimestamp,
+      .queryCount = 2
+    };
+
+    vk_queryPools.emplace_back(device->logical().createQueryPool(ci_queryPool));
   }
 }
 
@@ -121,24 +234,159 @@ void Renderer::setCamera(unsigned long e_id)
   camera_id = e_id;
 }
 
-void Renderer::checkResult(const vk::Result& result, std::string errorType) const
+void Renderer::setTransforms(std::shared_ptr<TransformStore> store)
+{
+  transforms = store;
+}
+
+void Renderer::setBackend(Backend b)
+{
+  if (backend == b)
+    return;
+
+  backend = b;
+  invalidate();
+}
+
+void Renderer::setProfiler(std::shared_ptr<Profiler> p)
+{
+  profiler = p;
+}
+
+void Renderer::setJobs(std::shared_ptr<JobSystem> j)
+{
+  jobs = j;
+}
+
+void Renderer::checkResult(const vk::Result& result, std::string errorType)
 {
   if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR)
+  {
     vecs_gui->recreateSwapchain(*vecs_device);
+    invalidate();
+  }
   else if (result != vk::Result::eSuccess)
     throw std::runtime_error("error @ str::Renderer::checkResult() : failed to " + errorType + " image");
 }
 
-void Renderer::begin(unsigned int imageIndex)
+vk::Extent2D Renderer::extent() const
+{
+  return offscreen ? offscreen->extent() : VECS_SETTINGS.extent();
+}
+
+vk::Image Renderer::target(unsigned int imageIndex) const
+{
+  return offscreen ? offscreen->image() : vecs_gui->image(imageIndex);
+}
+
+unsigned int Renderer::targetCount() const
+{
+  return offscreen ? 1u : static_cast<unsigned int>(vecs_gui->swapchain().getImages().size());
+}
+
+// drops every recorded trace, reallocating for the current number of target images; the old
+// buffers may still be pending, so the device is drained first
+void Renderer::invalidate()
+{
+  if (!device || !*vk_commandPool)
+    return;
+
+  device->logical().waitIdle();
+  targets = targetCount();
+
+  vk::CommandBufferAllocateInfo ai_traceBuffers{
+    .commandPool        = *vk_commandPool,
+    .level              = vk::CommandBufferLevel::ePrimary,
+    .commandBufferCount = static_cast<unsigned int>(VECS_SETTINGS.max_flight_frames() * targets)
+  };
+
+  vk_traceBuffers = nullptr;
+  vk_traceBuffers = vk::raii::CommandBuffers(device->logical(), ai_traceBuffers);
+  recordings.assign(ai_traceBuffers.commandBufferCount, std::nullopt);
+}
+
+// called once the frame's fence has signalled, so the queries are already available
+void Renderer::readTimestamps()
+{
+  if (vk_queryPools.empty() || !timed[frame])
+    return;
+
+  auto [result, stamps] = vk_queryPools[frame].getResults<unsigned long>(
+    0,
+    2,
+    2 * sizeof(unsigned long),
+    sizeof(unsigned long),
+    vk::QueryResultFlagBits::e64
+  );
+
+  if (result == vk::Result::eSuccess)
+    profiler->record(Phase::Gpu, (stamps[1] - stamps[0]) * timestampPeriod / 1e6f);
+
+  timed[frame] = false;
+}
+
+// the per-frame part: staging copies and the start timestamp, recorded fresh every frame
+void Renderer::recordFrame(Camera& camera)
+{
+  const vk::raii::CommandBuffer& vk_commandBuffer = vk_commandBuffers[frame];
+
+  vk::CommandBufferBeginInfo beginInfo{
+    .flags  = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  };
+  vk_commandBuffer.begin(beginInfo);
+
+  if (!vk_queryPools.empty())
+  {
+    vk_commandBuffer.resetQueryPool(*vk_queryPools[frame], 0, 2);
+    vk_commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *vk_queryPools[frame], 0);
+    timed[frame] = true;
+  }
+
+  camera.recordUploads(vk_commandBuffer, frame);
+
+  vk_commandBuffer.end();
+}
+
+// the trace itself, which only depends on the frame slot, the target image and the camera
+void Renderer::recordTrace(Camera& camera, unsigned int imageIndex, const vk::raii::CommandBuffer& vk_commandBuffer)
 {
   vk::CommandBufferBeginInfo beginInfo{};
-  vk_commandBuffers[frame].begin(beginInfo);
+  vk_commandBuffer.begin(beginInfo);
+
+  begin(vk_commandBuffer, imageIndex);
+  render(vk_commandBuffer, camera, imageIndex);
+  end(vk_commandBuffer, imageIndex);
+
+  vk_commandBuffer.end();
+}
+
+void Renderer::begin(const vk::raii::CommandBuffer& vk_commandBuffer, unsigned int imageIndex)
+{
+  // the previous frame must finish accumulating, and blitting when computing, before this frame
+  // reads and writes the image again
+  vk::MemoryBarrier accumulationBarrier{
+    .srcAccessMask  = vk::AccessFlagBits::eShaderWrite,
+    .dstAccessMask  = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite
+  };
 
+  vk_commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader,
+    vk::DependencyFlags(),
+    accumulationBarrier,
+    nullptr,
+    nullptr
+  );
+
+  bool graphics = backend == Backend::Graphics;
+
+  // the offscreen image is reused every frame, so wait for the previous frame's readback
   vk::ImageMemoryBarrier memoryBarrier{
-    .dstAccessMask    = vk::AccessFlagBits::eColorAttachmentWrite,
+    .srcAccessMask    = offscreen ? vk::AccessFlagBits::eTransferRead : vk::AccessFlags(),
+    .dstAccessMask    = graphics ? vk::AccessFlagBits::eColorAttachmentWrite : vk::AccessFlagBits::eTransferWrite,
     .oldLayout        = vk::ImageLayout::eUndefined,
-    .newLayout        = vk::ImageLayout::eColorAttachmentOptimal,
-    .image            = vecs_gui->image(imageIndex),
+    .newLayout        = graphics ? vk::ImageLayout::eColorAttachmentOptimal : vk::ImageLayout::eTransferDstOptimal,
+    .image            = target(imageIndex),
     .subresourceRange = {
       .aspectMask       = vk::ImageAspectFlagBits::eColor,
       .baseMipLevel     = 0,
@@ -148,17 +396,23 @@ void Renderer::begin(unsigned int imageIndex)
     }
   };
 
-  vk_commandBuffers[frame].pipelineBarrier(
-    vk::PipelineStageFlagBits::eTopOfPipe,
-    vk::PipelineStageFlagBits::eColorAttachmentOutput,
+  vk_commandBuffer.pipelineBarrier(
+    offscreen || !graphics ? vk::PipelineStageFlagBits::eTransfer : vk::PipelineStageFlagBits::eTopOfPipe,
+    graphics ? vk::PipelineStageFlagBits::eColorAttachmentOutput : vk::PipelineStageFlagBits::eTransfer,
     vk::DependencyFlags(),
     nullptr,
     nullptr,
     memoryBarrier
   );
 
+  if (!graphics)
+    return;
+
+  vk::ImageView colorView = offscreen ? *offscreen->imageView() : *vecs_gui->imageView(imageIndex);
+  vk::ImageView depthView = offscreen ? *offscreen->depthView() : *vecs_gui->depthView();
+
   vk::RenderingAttachmentInfo i_color{
-    .imageView    = *vecs_gui->imageView(imageIndex),
+    .imageView    = colorView,
     .imageLayout  = vk::ImageLayout::eColorAttachmentOptimal,
     .loadOp       = vk::AttachmentLoadOp::eClear,
     .storeOp      = vk::AttachmentStoreOp::eStore,
@@ -166,7 +420,7 @@ void Renderer::begin(unsigned int imageIndex)
   };
 
   vk::RenderingAttachmentInfo i_depth{
-    .imageView    = *vecs_gui->depthView(),
+    .imageView    = depthView,
     .imageLayout  = vk::ImageLayout::eDepthAttachmentOptimal,
     .loadOp       = vk::AttachmentLoadOp::eClear,
     .storeOp      = vk::AttachmentStoreOp::eDontCare,
@@ -177,78 +431,153 @@ void Renderer::begin(unsigned int imageIndex)
 
   vk::RenderingInfo i_rendering{
     .renderArea           = { .offset = { 0, 0 },
-                              .extent = VECS_SETTINGS.extent() },
+                              .extent = extent() },
     .layerCount           = 1,
     .colorAttachmentCount = 1,
     .pColorAttachments    = &i_color,
     .pDepthAttachment     = &i_depth
   };
 
-  vk_commandBuffers[frame].beginRenderingKHR(i_rendering);
+  vk_commandBuffer.beginRenderingKHR(i_rendering);
 
   vk::Viewport vk_viewport{
     .x = 0.0f,
     .y = 0.0f,
-    .width = static_cast<float>(VECS_SETTINGS.extent().width),
-    .height = static_cast<float>(VECS_SETTINGS.extent().height),
+    .width = static_cast<float>(extent().width),
+    .height = static_cast<float>(extent().height),
     .minDepth = 0.0f,
     .maxDepth = 1.0f
   };
-  vk_commandBuffers[frame].setViewport(0, vk_viewport);
+  vk_commandBuffer.setViewport(0, vk_viewport);
 
   vk::Rect2D vk_scissor{
     .offset = {0, 0},
-    .extent = VECS_SETTINGS.extent()
+    .extent = extent()
   };
-  vk_commandBuffers[frame].setScissor(0, vk_scissor);
+  vk_commandBuffer.setScissor(0, vk_scissor);
 }
 
-void Renderer::render(std::shared_ptr<vecs::ComponentManager> component_manager, unsigned int imageIndex)
+void Renderer::render(const vk::raii::CommandBuffer& vk_commandBuffer, Camera& camera, unsigned int imageIndex)
 {
-  auto camera = component_manager->retrieve<p_camera>(camera_id).value();
+  if (backend == Backend::Compute)
+  {
+    dispatch(vk_commandBuffer, camera, imageIndex);
+    return;
+  }
 
-  vk_commandBuffers[frame].bindPipeline(
+  vk_commandBuffer.bindPipeline(
     vk::PipelineBindPoint::eGraphics,
-    *camera->pipeline()
+    *camera.pipeline()
   );
 
-  vk_commandBuffers[frame].bindDescriptorSets(
+  vk_commandBuffer.bindDescriptorSets(
     vk::PipelineBindPoint::eGraphics,
-    *camera->pipelineLayout(),
+    *camera.pipelineLayout(),
     0,
-    *camera->descriptorSet(frame),
+    *camera.descriptorSet(frame),
     nullptr
   );
 
-  vk_commandBuffers[frame].pushConstants<la::mat<4>>(
-    *camera->pipelineLayout(),
-    vk::ShaderStageFlagBits::eVertex,
+  vk_commandBuffer.bindVertexBuffers(0, *camera.vertexBuffer(), { 0 });
+  vk_commandBuffer.bindIndexBuffer(*camera.indexBuffer(), 0, vk::IndexType::eUint32);
+
+  vk_commandBuffer.drawIndexed(6, 1, 0, 0, 0);
+}
+
+void Renderer::dispatch(const vk::raii::CommandBuffer& vk_commandBuffer, Camera& camera, unsigned int imageIndex)
+{
+  vk_commandBuffer.bindPipeline(
+    vk::PipelineBindPoint::eCompute,
+    *camera.computePipeline()
+  );
+
+  vk_commandBuffer.bindDescriptorSets(
+    vk::PipelineBindPoint::eCompute,
+    *camera.computePipelineLayout(),
     0,
-    camera->view_matrix()
+    *camera.descriptorSet(frame),
+    nullptr
+  );
+
+  const vk::Extent2D& size = camera.accumulationExtent();
+  const auto& workgroup = camera.workgroupSize();
+
+  vk_commandBuffer.dispatch(
+    (size.width + workgroup[0] - 1) / workgroup[0],
+    (size.height + workgroup[1] - 1) / workgroup[1],
+    1
   );
 
-  vk_commandBuffers[frame].pushConstants<la::vec<3>>(
-    *camera->pipelineLayout(),
-    vk::ShaderStageFlagBits::eVertex,
-    sizeof(la::mat<4>),
-    camera->near_plane_dimensions()
+  vk::ImageSubresourceRange range{
+    .aspectMask     = vk::ImageAspectFlagBits::eColor,
+    .baseMipLevel   = 0,
+    .levelCount     = 1,
+    .baseArrayLayer = 0,
+    .layerCount     = 1
+  };
+
+  vk::ImageMemoryBarrier memoryBarrier{
+    .srcAccessMask    = vk::AccessFlagBits::eShaderWrite,
+    .dstAccessMask    = vk::AccessFlagBits::eTransferRead,
+    .oldLayout        = vk::ImageLayout::eGeneral,
+    .newLayout        = vk::ImageLayout::eGeneral,
+    .image            = camera.accumulationImage(),
+    .subresourceRange = range
+  };
+
+  vk_commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eComputeShader,
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::DependencyFlags(),
+    nullptr,
+    nullptr,
+    memoryBarrier
   );
 
-  vk_commandBuffers[frame].bindVertexBuffers(0, *camera->vertexBuffer(), { 0 });
-  vk_commandBuffers[frame].bindIndexBuffer(*camera->indexBuffer(), 0, vk::IndexType::eUint32);
+  vk::ImageSubresourceLayers layers{
+    .aspectMask     = vk::ImageAspectFlagBits::eColor,
+    .mipLevel       = 0,
+    .baseArrayLayer = 0,
+    .layerCount     = 1
+  };
 
-  vk_commandBuffers[frame].drawIndexed(6, 1, 0, 0, 0);
+  // blitting converts the float accumulation to the target format, sRGB encoding included
+  vk::ImageBlit region{
+    .srcSubresource = layers,
+    .srcOffsets     = std::array<vk::Offset3D, 2>{
+      vk::Offset3D{ 0, 0, 0 },
+      vk::Offset3D{ static_cast<int>(size.width), static_cast<int>(size.height), 1 }
+    },
+    .dstSubresource = layers,
+    .dstOffsets     = std::array<vk::Offset3D, 2>{
+      vk::Offset3D{ 0, 0, 0 },
+      vk::Offset3D{ static_cast<int>(extent().width), static_cast<int>(extent().height), 1 }
+    }
+  };
+
+  vk_commandBuffer.blitImage(
+    camera.accumulationImage(),
+    vk::ImageLayout::eGeneral,
+    target(imageIndex),
+    vk::ImageLayout::eTransferDstOptimal,
+    region,
+    vk::Filter::eNearest
+  );
 }
 
-void Renderer::end(unsigned int imageIndex)
+void Renderer::end(const vk::raii::CommandBuffer& vk_commandBuffer, unsigned int imageIndex)
 {
-  vk_commandBuffers[frame].endRendering();
+  bool graphics = backend == Backend::Graphics;
+
+  if (graphics)
+    vk_commandBuffer.endRendering();
 
   vk::ImageMemoryBarrier memoryBarrier{
-    .srcAccessMask    = vk::AccessFlagBits::eColorAttachmentWrite,
-    .oldLayout        = vk::ImageLayout::eColorAttachmentOptimal,
-    .newLayout        = vk::ImageLayout::ePresentSrcKHR,
-    .image            = vecs_gui->image(imageIndex),
+    .srcAccessMask    = graphics ? vk::AccessFlagBits::eColorAttachmentWrite : vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask    = offscreen ? vk::AccessFlagBits::eTransferRead : vk::AccessFlags(),
+    .oldLayout        = graphics ? vk::ImageLayout::eColorAttachmentOptimal : vk::ImageLayout::eTransferDstOptimal,
+    .newLayout        = offscreen ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR,
+    .image            = target(imageIndex),
     .subresourceRange = {
       .aspectMask       = vk::ImageAspectFlagBits::eColor,
       .baseMipLevel     = 0,
@@ -258,16 +587,20 @@ void Renderer::end(unsigned int imageIndex)
     }
   };
 
-  vk_commandBuffers[frame].pipelineBarrier(
-    vk::PipelineStageFlagBits::eColorAttachmentOutput,
-    vk::PipelineStageFlagBits::eBottomOfPipe,
+  vk_commandBuffer.pipelineBarrier(
+    graphics ? vk::PipelineStageFlagBits::eColorAttachmentOutput : vk::PipelineStageFlagBits::eTransfer,
+    offscreen ? vk::PipelineStageFlagBits::eTransfer : vk::PipelineStageFlagBits::eBottomOfPipe,
     vk::DependencyFlags(),
     nullptr,
     nullptr,
     memoryBarrier
   );
 
-  vk_commandBuffers[frame].end();
+  if (offscreen)
+    offscreen->recordReadback(vk_commandBuffer, frame);
+
+  if (!vk_queryPools.empty())
+    vk_commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *vk_queryPools[frame], 1);
 }
 
 } // namespace str
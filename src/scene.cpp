@@ -0,0 +1,60 @@
+#include "src/include/scene.hpp"
+
+namespace str
+{
+
+std::vector<Transform> defaultScene()
+{
+  auto sphere = Transform({ 0.0, 1.0, 0.0 })
+    .translate(10.0, { 0.0, 0.0, 1.0 })
+    .scale({ 0.6, 0.0, 0.0 });
+
+  return { sphere };
+}
+
+std::vector<Transform> gridScene(unsigned long count)
+{
+  unsigned long side = 1;
+  while (side * side * side < count)
+    ++side;
+
+  float spacing = 1.5f;
+  float offset = (side - 1) * spacing / 2;
+
+  std::vector<Transform> objects;
+  objects.reserve(count);
+
+  for (unsigned long i = 0; i < count; ++i)
+  {
+    la::vec<3> p = {
+      (i % side) * spacing - offset,
+      (i / side % side) * spacing - offset,
+      (i / (side * side)) * spacing + 10.0f
+    };
+
+    la::vec<3> color = {
+      static_cast<float>(i % side) / side,
+      static_cast<float>(i / side % side) / side,
+      0.5f
+    };
+
+    objects.push_back(Transform(color).translate(p.norm(), p).scale({ -0.5, 0.0, 0.0 }));
+  }
+
+  return objects;
+}
+
+std::vector<Transform> lensScene()
+{
+  auto lens = Transform({ 0.0, 0.0, 0.0 })
+    .translate(5.0, { 0.0, 0.0, 1.0 })
+    .scale({ -1.0, 0.0, 0.0 })
+    .mass(0.05f);
+
+  std::vector<Transform> objects = defaultScene();
+  objects.push_back(lens);
+
+  return objects;
+}
+
+} // namespace str
@@ -0,0 +1,138 @@
+#include "src/include/simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace str
+{
+
+Simulation::~Simulation()
+{
+  stop();
+}
+
+// publishes the initial scene as tick 0 so the first frame has something to draw
+void Simulation::start(const TransformStore& initial, Step s, unsigned long d)
+{
+  stop();
+
+  world = initial;
+  step = s;
+  depth = std::max(d, 1ul);
+
+  ticks = 0;
+  rendered = 0;
+  acquired = 0;
+  unseen.clear();
+  stale.fill(std::nullopt);
+  publish(0.0f);
+
+  running = true;
+  worker = std::thread(&Simulation::run, this);
+}
+
+void Simulation::stop()
+{
+  if (!worker.joinable())
+    return;
+
+  // bumping the counter wakes the worker if it is waiting for the renderer to catch up
+  running = false;
+  rendered.fetch_add(1);
+  rendered.notify_one();
+
+  worker.join();
+}
+
+// the newest published snapshot, or nullptr when nothing new arrived since the last call
+const Snapshot * Simulation::acquire()
+{
+  if (!snapshots.update())
+    return nullptr;
+
+  acquired.store(snapshots.front().tick + 1, std::memory_order_release);
+  return &snapshots.front();
+}
+
+// marks one frame as rendered, letting the simulation run one more tick ahead
+void Simulation::release()
+{
+  rendered.fetch_add(1);
+  rendered.notify_one();
+}
+
+void Simulation::run()
+{
+  auto begin = std::chrono::steady_clock::now();
+  auto last = begin;
+
+  while (running)
+  {
+    unsigned long done = rendered.load();
+    if (ticks.load() >= done + depth)
+    {
+      rendered.wait(done);
+      continue;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float>(now - begin).count();
+    float delta = std::chrono::duration<float>(now - last).count();
+    last = now;
+
+    step(world, pose, elapsed, delta);
+    publish(elapsed);
+  }
+}
+
+// the snapshot stores persist, so each only copies the slots changed since it was last written. the
+// renderer may skip any number of snapshots, so each one reports every change since the newest tick
+// the renderer is known to have acquired; a stale count only makes the range wider
+void Simulation::publish(float elapsed)
+{
+  Snapshot& next = snapshots.back();
+
+  SlotRange changed = world.takeChanges();
+
+  unseen.push_back(TickChanges{ .tick = ticks.load(), .slots = changed, .camera = pose });
+  pose.reset();
+
+  unsigned long seen = acquired.load(std::memory_order_acquire);
+  while (!unseen.empty() && unseen.front().tick < seen)
+    unseen.pop_front();
+
+  SlotRange slots;
+  std::optional<CameraPose> camera;
+  for (const TickChanges& tick : unseen)
+  {
+    slots.merge(tick.slots);
+    if (tick.camera)
+      camera = tick.camera;
+  }
+
+  for (auto& range : stale)
+  {
+    if (range)
+      range->merge(changed);
+  }
+
+  std::optional<SlotRange>& behind = stale[snapshots.backIndex()];
+  if (behind)
+    next.transforms->copy(world, *behind);
+  else
+    *next.transforms = world;
+
+  behind = SlotRange{};
+
+  next.transforms->takeChanges();
+  next.transforms->keepChanges(slots);
+  next.camera = camera;
+
+  next.tick = ticks.load();
+  next.elapsed = elapsed;
+
+  snapshots.publish();
+  ++ticks;
+}
+
+} // namespace str
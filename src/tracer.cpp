@@ -0,0 +1,405 @@
+#include "src/include/tracer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace str
+{
+
+static constexpr float inf = std::numeric_limits<float>::infinity();
+static constexpr float EPSILON = 1e-4f;
+static const la::vec<3> SKY_LIGHT = { 0.5294, 0.8078, 0.9216 };
+static const la::vec<3> SKY_DARK = { 0.0980, 0.0980, 0.4392 };
+
+Tracer::Tracer(JobSystem& j, unsigned int tile) : jobs(j), tile_size(std::max(tile, 1u))
+{
+}
+
+unsigned int Tracer::threads() const
+{
+  return jobs.threads();
+}
+
+void Tracer::setTolerances(const Tolerances& t)
+{
+  tolerances = t;
+}
+
+// bends rays with the table's lookups instead of integrating them, or integrates again for nullptr
+void Tracer::setLensing(const LensingTable * table)
+{
+  lensing = table;
+}
+
+TraceStats Tracer::render(Framebuffer& framebuffer, const la::mat<4>& view, const la::vec<3>& dims,
+                          const TransformStore& transforms, const BVH& hierarchy)
+{
+  auto begin = std::chrono::steady_clock::now();
+
+  target = &framebuffer;
+  store = &transforms;
+  bvh = &hierarchy;
+  basis = rayBasis(view, dims, framebuffer.width, framebuffer.height);
+  lenses = gatherLenses(transforms);
+
+  // the same per-object pass Camera::updateSSBO runs before an upload
+  boosts.resize(transforms.size());
+  computeBoosts(transforms, boosts.data(), 0, transforms.size(), jobs);
+
+  tiles_x = (framebuffer.width + tile_size - 1) / tile_size;
+  tile_count = tiles_x * ((framebuffer.height + tile_size - 1) / tile_size);
+
+  ray_count = 0;
+  step_count = 0;
+
+  // one tile per job, so threads that finish cheap tiles early steal the expensive ones
+  jobs.parallel_for(0, tile_count, 1, [this](unsigned long first, unsigned long last) {
+    unsigned long rays = 0;
+    unsigned long steps = 0;
+    for (unsigned long tile = first; tile < last; ++tile)
+      renderTile(tile, rays, steps);
+
+    ray_count += rays;
+    step_count += steps;
+  });
+
+  auto end = std::chrono::steady_clock::now();
+
+  return TraceStats{
+    .rays     = ray_count.load(),
+    .steps    = step_count.load(),
+    .seconds  = std::chrono::duration<float>(end - begin).count(),
+    .threads  = threads()
+  };
+}
+
+void Tracer::renderTile(unsigned long tile, unsigned long& rays, unsigned long& steps) const
+{
+  Framebuffer& framebuffer = *target;
+
+  unsigned int x0 = static_cast<unsigned int>(tile % tiles_x) * tile_size;
+  unsigned int y0 = static_cast<unsigned int>(tile / tiles_x) * tile_size;
+  unsigned int x1 = std::min(x0 + tile_size, framebuffer.width);
+  unsigned int y1 = std::min(y0 + tile_size, framebuffer.height);
+
+  for (unsigned int y = y0; y < y1; ++y)
+  {
+    for (unsigned int x = x0; x < x1; ++x)
+    {
+      // the pixel center, as camera.frag generates it without jitter
+      la::vec<3> point = basis.corner + (x + 0.5f) * basis.dx + (y + 0.5f) * basis.dy;
+
+      Ray ray{ basis.origin, (point - basis.origin).normalized(), la::vec<3>::zero() };
+      framebuffer(x, y) = trace(ray, rays, steps).color;
+    }
+  }
+}
+
+Tracer::HitInfo Tracer::raySphere(unsigned long slot, const Ray& ray) const
+{
+  if (boosts[slot].motion[3] > 1.0f)
+    return rayMovingSphere(slot, ray);
+
+  const la::vec<3>& position = store->positions()[slot];
+
+  la::vec<3> O = ray.origin - position;
+  float R = store->sizes()[slot][0];
+
+  float b = 2 * (O * ray.dir);
+  float c = O * O - R * R;
+  float disc = b * b - 4 * c;
+
+  if (disc < 0)
+    return HitInfo{};
+
+  float t = -(b + std::sqrt(disc)) / 2;
+  la::vec<3> P = ray.origin + t * ray.dir;
+
+  return HitInfo{
+    .hit    = true,
+    .t      = t,
+    .point  = P,
+    .normal = (P - position).normalized(),
+    .color  = store->colors()[slot]
+  };
+}
+
+// intersected in the sphere's rest frame, where the ray is still a straight line: its origin is
+// the boosted event (origin - position, time) and each unit of t adds the boosted (dir, -1)
+Tracer::HitInfo Tracer::rayMovingSphere(unsigned long slot, const Ray& ray) const
+{
+  const Boost& boost = boosts[slot];
+
+  la::vec<4> o = boost.matrix * la::vec<4>(ray.origin - store->positions()[slot], { ray.time });
+  la::vec<4> d = boost.matrix * la::vec<4>(ray.dir, { -1.0f });
+
+  la::vec<3> O = { o[0], o[1], o[2] };
+  la::vec<3> D = { d[0], d[1], d[2] };
+  float R = store->sizes()[slot][0];
+
+  float a = D * D;
+  float b = O * D;
+  float c = O * O - R * R;
+  float disc = b * b - a * c;
+
+  if (disc < 0)
+    return HitInfo{};
+
+  float t = -(b + std::sqrt(disc)) / a;
+
+  // light older than the horizon is outside the object's bounds in the BVH
+  if (ray.time - t < -STR_RELATIVITY_HORIZON)
+    return HitInfo{};
+
+  // the rest frame normal, carried back through the length contraction
+  la::vec<4> n = boost.matrix * la::vec<4>(O + t * D, { 0.0f });
+
+  return HitInfo{
+    .hit    = true,
+    .t      = t,
+    .point  = ray.origin + t * ray.dir,
+    .normal = la::vec<3>{ n[0], n[1], n[2] }.normalized(),
+    .color  = shift(store->colors()[slot], doppler(boost, ray.dir))
+  };
+}
+
+float Tracer::rayBox(const BVHNode& node, const Ray& ray, const la::vec<3>& invDir, float tMax) const
+{
+  float tEnter = 0.0f;
+  float tExit = tMax;
+
+  for (unsigned long axis = 0; axis < 3; ++axis)
+  {
+    float t0 = (node.lo[axis] - ray.origin[axis]) * invDir[axis];
+    float t1 = (node.hi[axis] - ray.origin[axis]) * invDir[axis];
+
+    tEnter = std::max(tEnter, std::min(t0, t1));
+    tExit = std::min(tExit, std::max(t0, t1));
+  }
+
+  return tEnter <= tExit ? tEnter : inf;
+}
+
+// the nearest sphere along the ray closer than tMax
+Tracer::HitInfo Tracer::intersect(const Ray& ray, float tMax) const
+{
+  HitInfo hit{ .t = tMax };
+
+  const std::vector<BVHNode>& nodes = bvh->nodes();
+  const std::vector<unsigned int>& indices = bvh->indices();
+
+  la::vec<3> invDir = { 1.0f / ray.dir[0], 1.0f / ray.dir[1], 1.0f / ray.dir[2] };
+  if (store->size() == 0 || nodes.empty() || rayBox(nodes[0], ray, invDir, hit.t) == inf)
+    return HitInfo{ .t = inf };
+
+  unsigned int stack[STR_STACK_SIZE];
+  unsigned int sp = 0;
+  unsigned int index = 0;
+
+  while (true)
+  {
+    const BVHNode& node = nodes[index];
+
+    if (node.count > 0)
+    {
+      for (unsigned int i = node.left_first; i < node.left_first + node.count; ++i)
+      {
+        HitInfo info = raySphere(indices[i], ray);
+
+        if (info.hit && info.t > EPSILON && info.t < hit.t)
+          hit = info;
+      }
+
+      if (sp == 0)
+        break;
+
+      index = stack[--sp];
+      continue;
+    }
+
+    unsigned int closer = node.left_first;
+    unsigned int farther = node.left_first + 1;
+    float tNear = rayBox(nodes[closer], ray, invDir, hit.t);
+    float tFar = rayBox(nodes[farther], ray, invDir, hit.t);
+
+    if (tFar < tNear)
+    {
+      std::swap(closer, farther);
+      std::swap(tNear, tFar);
+    }
+
+    if (tNear == inf)
+    {
+      if (sp == 0)
+        break;
+
+      index = stack[--sp];
+      continue;
+    }
+
+    // BVH::build bounds the depth by the stack size, so the guard never drops a subtree
+    index = closer;
+    if (tFar != inf && sp < STR_STACK_SIZE)
+      stack[sp++] = farther;
+  }
+
+  if (!hit.hit)
+    hit.t = inf;
+
+  return hit;
+}
+
+// treats every mass ahead of the ray as a thin lens: the ray runs straight to its closest approach,
+// then turns towards the mass by the tabulated angle; one lookup counts as one step
+Tracer::HitInfo Tracer::deflect(Ray& ray, unsigned long& steps) const
+{
+  std::vector<bool> passed(lenses.size(), false);
+
+  for (unsigned long pass = 0; pass < lenses.size(); ++pass)
+  {
+    unsigned long next = lenses.size();
+    float tNext = inf;
+
+    for (unsigned long i = 0; i < lenses.size(); ++i)
+    {
+      la::vec<3> lens = { lenses[i].position[0], lenses[i].position[1], lenses[i].position[2] };
+      float t = (lens - ray.origin) * ray.dir;
+
+      if (!passed[i] && t > 0.0f && t < tNext)
+      {
+        next = i;
+        tNext = t;
+      }
+    }
+
+    if (next == lenses.size())
+      break;
+
+    ++steps;
+
+    HitInfo hit = intersect(ray, tNext);
+    if (hit.hit)
+      return hit;
+
+    la::vec<3> lens = { lenses[next].position[0], lenses[next].position[1], lenses[next].position[2] };
+    float rs = 2.0f * lenses[next].mass;
+
+    la::vec<3> closest = ray.origin + tNext * ray.dir;
+    la::vec<3> toward = lens - closest;
+    float b = toward.norm();
+
+    if (rs >= CRITICAL_IMPACT * b)
+      return HitInfo{ .hit = true, .absorbed = true, .t = tNext, .point = closest };
+
+    float angle = lensing->sample(rs / b, rs / (lens - ray.origin).norm()).angle;
+
+    ray.origin = closest;
+    ray.time -= tNext;
+    ray.dir = (std::cos(angle) * ray.dir + (std::sin(angle) / b) * toward).normalized();
+    passed[next] = true;
+  }
+
+  return intersect(ray, inf);
+}
+
+// follows the ray's geodesic with adaptive Dormand-Prince steps, testing each accepted step as a
+// straight segment; on return the ray points along the path where it hit something or left the
+// masses behind, and steps counts every attempted step, rejected ones included
+Tracer::HitInfo Tracer::propagate(Ray& ray, unsigned long& steps) const
+{
+  if (lenses.empty())
+    return intersect(ray, inf);
+
+  if (lensing && !lensing->empty())
+    return deflect(ray, steps);
+
+  Photon photon{ ray.origin, ray.dir };
+  la::vec<3> k1 = bend(photon.x, photon.v, lenses);
+
+  float h = 0.1f * nearestLens(photon.x, lenses);
+  float travelled = 0.0f;
+  float start = ray.time;
+
+  for (unsigned int i = 0; i < tolerances.steps && travelled < tolerances.distance; ++i)
+  {
+    ++steps;
+
+    // a step no longer than the distance to the nearest mass can not jump over it
+    h = std::min(h, 0.5f * nearestLens(photon.x, lenses));
+
+    Photon next;
+    la::vec<3> k7;
+    float error = dormandPrince(photon, k1, h, lenses, next, k7, tolerances);
+
+    float scale = std::clamp(0.9f * std::pow(std::max(error, 1e-10f), -0.2f), 0.2f, 5.0f);
+
+    if (error > 1.0f)
+    {
+      h *= scale;
+      continue;
+    }
+
+    la::vec<3> segment = next.x - photon.x;
+    float length = segment.norm();
+
+    ray.origin = photon.x;
+    ray.dir = segment / length;
+    ray.time = start - travelled;
+
+    HitInfo hit = intersect(ray, length);
+    if (hit.hit)
+      return hit;
+
+    photon = next;
+    k1 = k7;
+    travelled += length;
+    h *= scale;
+
+    if (captured(photon.x, lenses))
+      return HitInfo{ .hit = true, .absorbed = true, .t = travelled, .point = photon.x };
+
+    if (escaped(photon, lenses))
+      break;
+  }
+
+  ray.origin = photon.x;
+  ray.dir = photon.v.normalized();
+  ray.time = start - travelled;
+
+  return intersect(ray, inf);
+}
+
+Tracer::Ray Tracer::trace(Ray ray, unsigned long& rays, unsigned long& steps) const
+{
+  for (unsigned int i = 0; i < STR_MAX_BOUNCES; ++i)
+  {
+    HitInfo hit = propagate(ray, steps);
+    ++rays;
+
+    // inside a horizon nothing comes back
+    if (hit.absorbed)
+      return ray;
+
+    if (!hit.hit)
+    {
+      float a = std::abs(ray.dir * la::vec<3>{ 0.0, -1.0, 0.0 });
+      ray.color = ray.color + (1 - a) * SKY_LIGHT + a * SKY_DARK;
+      return ray;
+    }
+
+    ray.color = ray.color + std::abs(ray.dir * hit.normal) * hit.color;
+    ray.origin = hit.point;
+    ray.time -= hit.t;
+
+    float alignment = ray.dir * hit.normal;
+    float invert = alignment < 0 ? -1.0f : 1.0f;
+
+    ray.dir = invert * (ray.dir - 2 * alignment * hit.normal);
+  }
+
+  return ray;
+}
+
+} // namespace str
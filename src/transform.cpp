@@ -1,42 +1,99 @@
 #include "src/include/transform.hpp"
 
+#include <cmath>
+
 namespace str
 {
 
 Transform::Transform(la::vec<3> c)
 {
-  color = c;
+  state.color = c;
+  rebuild();
 }
 
-const la::mat<4> Transform::model() const
+Transform::Transform(const TransformData& data) : state(data)
 {
-  la::mat<4> Rx = la::mat<4>::rotation_matrix(rotation[0], { 1.0, 0.0, 0.0 });
-  la::mat<4> Ry = la::mat<4>::rotation_matrix(rotation[1], { 0.0, -1.0, 0.0 });
-  la::mat<4> Rz = la::mat<4>::rotation_matrix(rotation[2], { 0.0, 0.0, 1.0 });
+  rebuild();
+}
 
-  la::mat<4> T = la::mat<4>::translation_matrix(position);
-  la::mat<4> R = Rz * Ry * Rx;
-  la::mat<4> S = la::mat<4>::scale_matrix(size[0], size[1], size[2]);
+const la::mat<4>& Transform::model() const
+{
+  return cached_model;
+}
 
-  return T * R * S;
+const la::mat<4>& Transform::inverse() const
+{
+  return cached_inverse;
 }
 
 Transform& Transform::scale(la::vec<3> s)
 {
-  size = size + s;
+  state.size = state.size + s;
+  rebuild();
   return *this;
 }
 
 Transform& Transform::translate(float mag, la::vec<3> dir)
 {
-  position = position + mag * dir.normalized();
+  state.position = state.position + mag * dir.normalized();
+  rebuild();
   return *this;
 }
 
 Transform& Transform::rotate(la::vec<3> r)
 {
-  rotation = rotation + r;
+  state.rotation = state.rotation + r;
+  rebuild();
   return *this;
 }
 
-} // namespace str
\ No newline at end of file
+Transform& Transform::mass(float m)
+{
+  weight = m;
+  return *this;
+}
+
+Transform& Transform::velocity(la::vec<3> v)
+{
+  vel = v;
+  return *this;
+}
+
+// run by every mutator, so the const accessors only read and are safe to share between threads
+void Transform::rebuild()
+{
+  const la::vec<3>& angles = state.rotation;
+  const la::vec<3>& s = state.size;
+  const la::vec<3>& p = state.position;
+
+  float sx = std::sin(angles[0]), cx = std::cos(angles[0]);
+  float sy = std::sin(angles[1]), cy = std::cos(angles[1]);
+  float sz = std::sin(angles[2]), cz = std::cos(angles[2]);
+
+  // columns of Rz * Ry * Rx, with Ry taken about -y to match the camera's up vector
+  la::vec<3> r0 = { cz * cy, sz * cy, sy };
+  la::vec<3> r1 = { -cz * sy * sx - sz * cx, -sz * sy * sx + cz * cx, cy * sx };
+  la::vec<3> r2 = { -cz * sy * cx + sz * sx, -sz * sy * cx - cz * sx, cy * cx };
+
+  cached_model = la::mat<4>{
+    la::vec<4>(s[0] * r0, { 0.0 }),
+    la::vec<4>(s[1] * r1, { 0.0 }),
+    la::vec<4>(s[2] * r2, { 0.0 }),
+    la::vec<4>(p, { 1.0 })
+  };
+
+  // (T * R * S)^-1 = S^-1 * R^T * T^-1
+  la::vec<3> inv_s = { 1 / s[0], 1 / s[1], 1 / s[2] };
+  la::vec<3> i0 = { r0[0] * inv_s[0], r1[0] * inv_s[1], r2[0] * inv_s[2] };
+  la::vec<3> i1 = { r0[1] * inv_s[0], r1[1] * inv_s[1], r2[1] * inv_s[2] };
+  la::vec<3> i2 = { r0[2] * inv_s[0], r1[2] * inv_s[1], r2[2] * inv_s[2] };
+
+  cached_inverse = la::mat<4>{
+    la::vec<4>(i0, { 0.0 }),
+    la::vec<4>(i1, { 0.0 }),
+    la::vec<4>(i2, { 0.0 }),
+    la::vec<4>(-(p[0] * i0 + p[1] * i1 + p[2] * i2), { 1.0 })
+  };
+}
+
+} // namespace str
@@ -0,0 +1,285 @@
+#include "src/include/transform_store.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace str
+{
+
+// rgb as unorm8 in the byte order unpackUnorm4x8() reads, with an opaque alpha
+static unsigned int packColor(const la::vec<3>& color)
+{
+  unsigned int packed = 255u << 24;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    packed |= static_cast<unsigned int>(std::clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f) << (8 * i);
+
+  return packed;
+}
+
+void SlotRange::merge(unsigned long f, unsigned long l)
+{
+  if (f >= l) return;
+
+  if (empty())
+  {
+    first = f;
+    last = l;
+    return;
+  }
+
+  first = std::min(first, f);
+  last = std::max(last, l);
+}
+
+unsigned long TransformStore::size() const
+{
+  return entities.size();
+}
+
+bool TransformStore::contains(unsigned long e_id) const
+{
+  return slots.find(e_id) != slots.end();
+}
+
+unsigned long TransformStore::slot(unsigned long e_id) const
+{
+  auto it = slots.find(e_id);
+  if (it == slots.end())
+    throw std::out_of_range("error @ str::TransformStore::slot() : entity " + std::to_string(e_id) + " has no transform");
+
+  return it->second;
+}
+
+unsigned long TransformStore::entity(unsigned long index) const
+{
+  return entities[index];
+}
+
+unsigned long TransformStore::revision() const
+{
+  return changes;
+}
+
+// counts inserts and erases, the changes that move entities between slots
+unsigned long TransformStore::layout() const
+{
+  return layout_changes;
+}
+
+// slots freed by erase() since the last call are clipped off the returned range
+SlotRange TransformStore::takeChanges()
+{
+  SlotRange range{ std::min(dirty.first, size()), std::min(dirty.last, size()) };
+  dirty = SlotRange{};
+
+  return range;
+}
+
+// reports the range again from the next takeChanges(), without counting as a new revision
+void TransformStore::keepChanges(const SlotRange& range)
+{
+  dirty.merge(range);
+}
+
+// brings a copy of source up to date when only the slots in range changed since the two last
+// matched; once an insert or erase moved entities between slots, everything is copied. the pending
+// changes of this store are left alone
+void TransformStore::copy(const TransformStore& source, const SlotRange& range)
+{
+  if (layout_changes != source.layout_changes || size() != source.size())
+  {
+    SlotRange kept = dirty;
+    *this = source;
+    dirty = kept;
+    return;
+  }
+
+  unsigned long first = std::min(range.first, size());
+  unsigned long last = std::min(range.last, size());
+
+  std::copy(source.pos_array.begin() + first, source.pos_array.begin() + last, pos_array.begin() + first);
+  std::copy(source.rot_array.begin() + first, source.rot_array.begin() + last, rot_array.begin() + first);
+  std::copy(source.size_array.begin() + first, source.size_array.begin() + last, size_array.begin() + first);
+  std::copy(source.color_array.begin() + first, source.color_array.begin() + last, color_array.begin() + first);
+  std::copy(source.mass_array.begin() + first, source.mass_array.begin() + last, mass_array.begin() + first);
+  std::copy(source.vel_array.begin() + first, source.vel_array.begin() + last, vel_array.begin() + first);
+
+  changes = source.changes;
+}
+
+void TransformStore::insert(unsigned long e_id, const Transform& transform)
+{
+  if (contains(e_id))
+  {
+    set(e_id, transform);
+    return;
+  }
+
+  const TransformData& data = transform.data();
+
+  slots.emplace(e_id, entities.size());
+  entities.emplace_back(e_id);
+
+  pos_array.emplace_back(data.position);
+  rot_array.emplace_back(data.rotation);
+  size_array.emplace_back(data.size);
+  color_array.emplace_back(data.color);
+  mass_array.emplace_back(transform.mass());
+  vel_array.emplace_back(transform.velocity());
+
+  ++layout_changes;
+  mark(entities.size() - 1, entities.size());
+}
+
+void TransformStore::erase(unsigned long e_id)
+{
+  unsigned long index = slot(e_id);
+  unsigned long last = entities.size() - 1;
+
+  if (index != last)
+  {
+    pos_array[index] = pos_array[last];
+    rot_array[index] = rot_array[last];
+    size_array[index] = size_array[last];
+    color_array[index] = color_array[last];
+    mass_array[index] = mass_array[last];
+    vel_array[index] = vel_array[last];
+
+    entities[index] = entities[last];
+    slots[entities[index]] = index;
+  }
+
+  pos_array.pop_back();
+  rot_array.pop_back();
+  size_array.pop_back();
+  color_array.pop_back();
+  mass_array.pop_back();
+  vel_array.pop_back();
+
+  entities.pop_back();
+  slots.erase(e_id);
+  ++layout_changes;
+
+  // the last slot moved into index; the size change itself is picked up through revision()
+  mark(index, std::min(index + 1, entities.size()));
+}
+
+void TransformStore::set(unsigned long e_id, const Transform& transform)
+{
+  unsigned long index = slot(e_id);
+  const TransformData& data = transform.data();
+
+  pos_array[index] = data.position;
+  rot_array[index] = data.rotation;
+  size_array[index] = data.size;
+  color_array[index] = data.color;
+  mass_array[index] = transform.mass();
+  vel_array[index] = transform.velocity();
+
+  mark(index, index + 1);
+}
+
+Transform TransformStore::get(unsigned long e_id) const
+{
+  unsigned long index = slot(e_id);
+
+  Transform transform(TransformData{
+    .position = pos_array[index],
+    .rotation = rot_array[index],
+    .size     = size_array[index],
+    .color    = color_array[index]
+  });
+
+  return transform.mass(mass_array[index]).velocity(vel_array[index]);
+}
+
+void TransformStore::translate(unsigned long first, unsigned long last, float mag, la::vec<3> dir)
+{
+  check(first, last);
+
+  la::vec<3> displacement = mag * dir.normalized();
+
+  for (unsigned long i = first; i < last; ++i)
+    pos_array[i] = pos_array[i] + displacement;
+
+  mark(first, last);
+}
+
+void TransformStore::translate(unsigned long first, std::span<const la::vec<3>> displacements)
+{
+  check(first, first + displacements.size());
+
+  la::vec<3> * p = pos_array.data() + first;
+
+  for (unsigned long i = 0; i < displacements.size(); ++i)
+    p[i] = p[i] + displacements[i];
+
+  mark(first, first + displacements.size());
+}
+
+void TransformStore::rotate(unsigned long first, unsigned long last, la::vec<3> r)
+{
+  check(first, last);
+
+  for (unsigned long i = first; i < last; ++i)
+    rot_array[i] = rot_array[i] + r;
+
+  mark(first, last);
+}
+
+void TransformStore::scale(unsigned long first, unsigned long last, la::vec<3> s)
+{
+  check(first, last);
+
+  for (unsigned long i = first; i < last; ++i)
+    size_array[i] = size_array[i] + s;
+
+  mark(first, last);
+}
+
+void TransformStore::pack(ObjectData * out) const
+{
+  pack(out, 0, entities.size());
+}
+
+// spheres are all the shaders trace, so rotations stay behind and the size reduces to a radius
+void TransformStore::pack(ObjectData * out, unsigned long first, unsigned long last) const
+{
+  check(first, last);
+
+  for (unsigned long i = first; i < last; ++i)
+  {
+    const la::vec<3>& p = pos_array[i];
+    const la::vec<3>& v = vel_array[i];
+
+    out[i].sphere = { p[0], p[1], p[2], size_array[i][0] };
+    out[i].color = packColor(color_array[i]);
+    out[i].flags = v[0] != 0.0f || v[1] != 0.0f || v[2] != 0.0f ? STR_OBJECT_MOVING : 0u;
+  }
+}
+
+// slots are written independently, so chunks of the range pack in parallel
+void TransformStore::pack(ObjectData * out, unsigned long first, unsigned long last, JobSystem& jobs) const
+{
+  check(first, last);
+
+  jobs.parallel_for(first, last, STR_JOB_GRAIN, [this, out](unsigned long begin, unsigned long end) {
+    pack(out, begin, end);
+  });
+}
+
+void TransformStore::check(unsigned long first, unsigned long last) const
+{
+  if (first > last || last > entities.size())
+    throw std::out_of_range("error @ str::TransformStore::check() : slot range out of bounds");
+}
+
+void TransformStore::mark(unsigned long first, unsigned long last)
+{
+  dirty.merge(first, last);
+  ++changes;
+}
+
+} // namespace str